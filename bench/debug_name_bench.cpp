@@ -0,0 +1,116 @@
+// Allocation count for per-frame debug names
+// Build and run with: make bench
+//
+// Screens need raylib and a window, so this replays the numbered names
+// NeonStrike and ParcelCorpsSettings build each frame (same prefixes and
+// loop counts) through a stand-in for with_debug_name. Compares the
+// previous "kill_" + std::to_string(i) form against DebugName with names
+// read (MCP, e2e) and not read. Names of up to 15 characters fit in the
+// string's inline buffer and never allocate, which covers all of
+// NeonStrike's; the settings rows' longer names are where allocations
+// show up.
+
+#include "../src/engine/debug_name.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+} // namespace
+
+void *operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// ComponentConfig keeps its own copy of the name
+std::string g_config_name;
+__attribute__((noinline)) void with_debug_name(std::string name) {
+  g_config_name = std::move(name);
+}
+
+// Numbered names NeonStrike builds per frame: 8 compass ticks, 3 kill feed
+// rows, 5 killstreak slots (cog, background, icon; one label) and the
+// minimap grid
+template <typename Make> void neon_strike_frame(Make &&make) {
+  for (int i = 0; i < 8; i++)
+    with_debug_name(make("compass_tick_", i));
+  for (size_t i = 0; i < 3; i++)
+    with_debug_name(make("kill_", i));
+  for (size_t i = 0; i < 5; i++) {
+    with_debug_name(make("cog_", i));
+    with_debug_name(make("ks_bg_", i));
+    with_debug_name(make("ks_icon_", i));
+  }
+  with_debug_name(make("ks_label_", 0));
+  for (int i = 1; i < 4; i++)
+    with_debug_name(make("grid_v_", i));
+  for (int i = 1; i < 3; i++)
+    with_debug_name(make("grid_h_", i));
+}
+
+// ParcelCorpsSettings' toggle, selector and display rows, keyed by base_id
+template <typename Make> void settings_rows_frame(Make &&make) {
+  for (int base_id = 200; base_id < 240; base_id += 10) {
+    for (const char *prefix :
+         {"toggle_row_", "toggle_icon_", "toggle_label_", "toggle_track_",
+          "toggle_knob_", "selector_row_", "selector_icon_", "selector_label_",
+          "selector_left_", "selector_value_", "selector_right_",
+          "display_row_", "display_icon_", "display_label_",
+          "display_value_"})
+      with_debug_name(make(prefix, base_id));
+  }
+}
+
+template <typename Frame, typename Make>
+void run_case(const char *label, Frame &&frame_names, Make &&make) {
+  constexpr int FRAMES = 100000;
+  frame_names(make);
+  size_t before = g_allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  for (int frame = 0; frame < FRAMES; frame++)
+    frame_names(make);
+  auto end = std::chrono::steady_clock::now();
+  size_t allocations = g_allocations.load() - before;
+  double ns =
+      std::chrono::duration<double, std::nano>(end - start).count() / FRAMES;
+  std::printf("%-34s %6.2f allocations/frame %8.1f ns/frame\n", label,
+              static_cast<double>(allocations) / FRAMES, ns);
+}
+
+template <typename Frame> void run_screen(const char *screen, Frame frame) {
+  auto concat = [](const char *prefix, auto i) {
+    return prefix + std::to_string(i);
+  };
+  auto lazy = [](const char *prefix, auto i) {
+    return static_cast<std::string>(DebugName(prefix, i));
+  };
+  char label[64];
+  std::snprintf(label, sizeof(label), "%s string concat", screen);
+  run_case(label, frame, concat);
+  debug_name::set_enabled(true);
+  std::snprintf(label, sizeof(label), "%s DebugName, read", screen);
+  run_case(label, frame, lazy);
+  debug_name::set_enabled(false);
+  std::snprintf(label, sizeof(label), "%s DebugName, not read", screen);
+  run_case(label, frame, lazy);
+}
+
+} // namespace
+
+int main() {
+  run_screen("NeonStrike", [](auto &&make) { neon_strike_frame(make); });
+  run_screen("ParcelCorps", [](auto &&make) { settings_rows_frame(make); });
+  return 0;
+}
@@ -0,0 +1,161 @@
+// Microbenchmark for testing/image_diff
+// Build and run with: make bench
+//
+// Compares the previous validator loops (a scalar RGB sum for
+// validate_screen and the two-pass per-pixel accessor loop from
+// compare_snapshot) against the single-pass diff_rgba kernel and the tiled
+// diff with cached baseline tile hashes.
+
+#include "../src/testing/image_diff.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Rgba {
+  uint8_t r, g, b, a;
+};
+
+// Mirrors raylib::GetImageColor: an out-of-line call per pixel
+__attribute__((noinline)) Rgba get_pixel(const std::vector<uint8_t> &img,
+                                         int width, int x, int y) {
+  const uint8_t *p = img.data() + (static_cast<size_t>(y) * width + x) * 4;
+  return Rgba{p[0], p[1], p[2], p[3]};
+}
+
+uint64_t legacy_validate(const std::vector<uint8_t> &a,
+                         const std::vector<uint8_t> &b, int width,
+                         int height) {
+  const Rgba *pa = reinterpret_cast<const Rgba *>(a.data());
+  const Rgba *pb = reinterpret_cast<const Rgba *>(b.data());
+  uint64_t total = 0;
+  for (int i = 0; i < width * height; i++) {
+    total += std::abs(static_cast<int>(pa[i].r) - static_cast<int>(pb[i].r));
+    total += std::abs(static_cast<int>(pa[i].g) - static_cast<int>(pb[i].g));
+    total += std::abs(static_cast<int>(pa[i].b) - static_cast<int>(pb[i].b));
+  }
+  return total;
+}
+
+int legacy_snapshot(const std::vector<uint8_t> &a,
+                    const std::vector<uint8_t> &b, int width, int height,
+                    int tolerance, std::vector<uint8_t> &mask) {
+  auto over = [&](int x, int y) {
+    Rgba ca = get_pixel(a, width, x, y);
+    Rgba cb = get_pixel(b, width, x, y);
+    return std::abs(ca.r - cb.r) > tolerance ||
+           std::abs(ca.g - cb.g) > tolerance ||
+           std::abs(ca.b - cb.b) > tolerance ||
+           std::abs(ca.a - cb.a) > tolerance;
+  };
+
+  int differences = 0;
+  for (int y = 0; y < height; y++)
+    for (int x = 0; x < width; x++)
+      differences += over(x, y) ? 1 : 0;
+
+  if (differences > 0) {
+    for (int y = 0; y < height; y++)
+      for (int x = 0; x < width; x++)
+        mask[static_cast<size_t>(y) * width + x] = over(x, y) ? 255 : 0;
+  }
+  return differences;
+}
+
+template <typename Fn> double time_ms(int iterations, Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    fn();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         iterations;
+}
+
+bool run_case(int width, int height, int iterations) {
+  const size_t bytes = static_cast<size_t>(width) * height * 4;
+  std::vector<uint8_t> a(bytes);
+  std::mt19937 rng(1234);
+  for (uint8_t &v : a)
+    v = static_cast<uint8_t>(rng() & 0xFF);
+
+  // Mostly identical frame with a changed block, like a blinking cursor
+  std::vector<uint8_t> b = a;
+  for (int y = height / 3; y < height / 3 + 40; y++)
+    for (int x = width / 2; x < width / 2 + 120; x++)
+      b[(static_cast<size_t>(y) * width + x) * 4] ^= 0x80;
+
+  std::vector<uint8_t> mask_legacy(static_cast<size_t>(width) * height);
+  std::vector<uint8_t> mask_new(static_cast<size_t>(width) * height);
+  const uint8_t tolerance = image_diff::tolerance_to_threshold(0.01f);
+
+  uint64_t legacy_total = 0;
+  int legacy_changed = 0;
+  double legacy = time_ms(iterations, [&] {
+    legacy_total = legacy_validate(a, b, width, height);
+    legacy_changed =
+        legacy_snapshot(a, b, width, height, tolerance, mask_legacy);
+  });
+
+  image_diff::DiffStats scalar_stats;
+  double scalar = time_ms(iterations, [&] {
+    scalar_stats = image_diff::diff_rgba_scalar(a.data(), b.data(), width,
+                                                height, tolerance,
+                                                mask_new.data());
+  });
+
+  image_diff::DiffStats stats;
+  double fast = time_ms(iterations, [&] {
+    stats = image_diff::diff_rgba(a.data(), b.data(), width, height,
+                                  tolerance, mask_new.data());
+  });
+
+  // Baseline hashes come from the baseline cache in the real validators
+  std::vector<uint64_t> b_tiles(
+      static_cast<size_t>(image_diff::tile_count(width, height)));
+  image_diff::hash_tiles(b.data(), width, height, b_tiles.data());
+  // Cached hashes must not depend on the backend that wrote them
+  std::vector<uint64_t> b_tiles_scalar(b_tiles.size());
+  image_diff::hash_tiles_scalar(b.data(), width, height,
+                                b_tiles_scalar.data());
+  std::vector<uint8_t> mask_tiled(static_cast<size_t>(width) * height);
+  image_diff::TiledDiff tiled;
+  double tiled_ms = time_ms(iterations, [&] {
+    tiled = image_diff::diff_rgba_tiled(a.data(), b.data(), width, height,
+                                        tolerance, mask_tiled.data(), nullptr,
+                                        b_tiles.data());
+  });
+
+  bool ok = stats.total_abs_diff == legacy_total &&
+            tiled.stats.total_abs_diff == legacy_total &&
+            tiled.stats.changed_pixels == legacy_changed &&
+            tiled.changed_regions.size() == 1 && mask_tiled == mask_legacy &&
+            b_tiles == b_tiles_scalar &&
+            stats.changed_pixels == legacy_changed &&
+            scalar_stats.total_abs_diff == legacy_total &&
+            scalar_stats.changed_pixels == legacy_changed &&
+            mask_new == mask_legacy;
+
+  std::printf("%5dx%-5d legacy %8.3f ms | scalar %8.3f ms | %s %8.3f ms | "
+              "tiled %8.3f ms (%d/%d tiles) | speedup %5.1fx / %5.1fx | "
+              "bbox (%d,%d)-(%d,%d) %s\n",
+              width, height, legacy, scalar, image_diff::active_backend(),
+              fast, tiled_ms, tiled.tiles_compared, tiled.tiles_total,
+              legacy / fast, legacy / tiled_ms, stats.min_x, stats.min_y,
+              stats.max_x, stats.max_y, ok ? "OK" : "MISMATCH");
+  return ok;
+}
+
+} // namespace
+
+int main() {
+  bool ok = true;
+  ok &= run_case(1280, 720, 20);
+  ok &= run_case(1920, 1080, 10);
+  ok &= run_case(3840, 2160, 5);
+  return ok ? 0 : 1;
+}
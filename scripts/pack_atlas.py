@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""
+Pack small sprites into texture atlas pages.
+
+Writes <out>/atlas_<n>.png pages and <out>/atlas.txt, the lookup table read
+by src/engine/sprite_atlas.cpp. Sprites are keyed by their path relative to
+the resources directory, e.g. images/icon_coin_small.png.
+
+Usage: pack_atlas.py --resources resources --out resources/atlas FILE...
+"""
+
+import argparse
+import os
+import sys
+
+from PIL import Image
+
+# Transparent gap around each sprite, its edge pixels are extruded into it
+# so linear filtering never samples a neighbour
+PADDING = 2
+
+
+def shelf_pack(sizes, page_size):
+    """Assigns (page, x, y) to each (w, h), tallest first, in shelf rows."""
+    order = sorted(range(len(sizes)),
+                   key=lambda i: (-sizes[i][1], -sizes[i][0]))
+    placements = [None] * len(sizes)
+    page, x, y, shelf_h = 0, 0, 0, 0
+    for i in order:
+        w = sizes[i][0] + PADDING * 2
+        h = sizes[i][1] + PADDING * 2
+        if w > page_size or h > page_size:
+            raise ValueError(f"sprite {i} ({sizes[i]}) does not fit a page")
+        if x + w > page_size:
+            x, y, shelf_h = 0, y + shelf_h, 0
+        if y + h > page_size:
+            page, x, y, shelf_h = page + 1, 0, 0, 0
+        placements[i] = (page, x + PADDING, y + PADDING)
+        x += w
+        shelf_h = max(shelf_h, h)
+    return placements
+
+
+def extrude(page, sprite, x, y):
+    """Pastes the sprite and repeats its border pixels into the padding."""
+    w, h = sprite.size
+    page.paste(sprite, (x, y))
+    for i in range(1, PADDING + 1):
+        page.paste(sprite.crop((0, 0, w, 1)), (x, y - i))
+        page.paste(sprite.crop((0, h - 1, w, h)), (x, y + h - 1 + i))
+    for i in range(1, PADDING + 1):
+        page.paste(page.crop((x, y - PADDING, x + 1, y + h + PADDING)),
+                   (x - i, y - PADDING))
+        page.paste(page.crop((x + w - 1, y - PADDING, x + w, y + h + PADDING)),
+                   (x + w - 1 + i, y - PADDING))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--resources", default="resources")
+    parser.add_argument("--out", default="resources/atlas")
+    parser.add_argument("--page-size", type=int, default=1024)
+    parser.add_argument("files", nargs="+")
+    args = parser.parse_args()
+
+    sprites = []
+    for path in sorted(set(args.files)):
+        key = os.path.relpath(path, args.resources).replace(os.sep, "/")
+        if any(c.isspace() for c in key):
+            parser.error(f"atlas keys cannot contain whitespace: {key}")
+        sprites.append((key, Image.open(path).convert("RGBA")))
+
+    placements = shelf_pack([s.size for _, s in sprites], args.page_size)
+    page_count = max(p[0] for p in placements) + 1
+
+    # Trim each page to the height it uses, rounded up to a power of two
+    heights = [0] * page_count
+    for (_, sprite), (page, _, y) in zip(sprites, placements):
+        heights[page] = max(heights[page], y + sprite.size[1] + PADDING)
+    pages = []
+    for height in heights:
+        rounded = 1
+        while rounded < height:
+            rounded *= 2
+        pages.append(Image.new("RGBA", (args.page_size, rounded), (0, 0, 0, 0)))
+
+    for (_, sprite), (page, x, y) in zip(sprites, placements):
+        extrude(pages[page], sprite, x, y)
+
+    os.makedirs(args.out, exist_ok=True)
+    lines = [f"# generated by scripts/pack_atlas.py, {len(sprites)} sprites"]
+    for index, page in enumerate(pages):
+        name = f"atlas_{index}.png"
+        page.save(os.path.join(args.out, name), "PNG", optimize=True)
+        lines.append(f"page {name} {page.size[0]} {page.size[1]}")
+    for (key, sprite), (page, x, y) in zip(sprites, placements):
+        w, h = sprite.size
+        lines.append(f"sprite {key} {page} {x} {y} {w} {h}")
+
+    with open(os.path.join(args.out, "atlas.txt"), "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print(f"Packed {len(sprites)} sprites into {page_count} page(s)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+Bundle the resources directory into one memory-mapped pack.
+
+Writes resources.pack, read by src/engine/resource_pack.cpp in place of the
+loose files. Entries are keyed by their path relative to the resources
+directory, e.g. fonts/Gaegu-Bold.ttf.
+
+Layout (little-endian):
+  header   magic "AHRP", u32 version, u32 entry count, u32 reserved
+  entries  sorted by key hash: u64 key hash, u64 offset, u64 size,
+           u32 key offset, u32 key size
+  keys     UTF-8, not terminated
+  data     each file starts on a 16 byte boundary
+
+Key hashes are FNV-1a 64.
+
+Usage: pack_resources.py --resources resources --out resources.pack
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"AHRP"
+VERSION = 1
+HEADER = struct.Struct("<4sIII")
+ENTRY = struct.Struct("<QQQII")
+ALIGN = 16
+
+FNV_OFFSET = 14695981039346656037
+FNV_PRIME = 1099511628211
+MASK = (1 << 64) - 1
+
+
+def fnv1a(data):
+    h = FNV_OFFSET
+    for byte in data:
+        h = ((h ^ byte) * FNV_PRIME) & MASK
+    return h
+
+
+def collect(root):
+    files = []
+    for directory, dirnames, filenames in os.walk(root):
+        dirnames[:] = sorted(d for d in dirnames if not d.startswith("."))
+        for name in sorted(filenames):
+            if name.startswith("."):
+                continue
+            path = os.path.join(directory, name)
+            key = os.path.relpath(path, root).replace(os.sep, "/")
+            files.append((key, path))
+    return files
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--resources", default="resources")
+    parser.add_argument("--out", default="resources.pack")
+    args = parser.parse_args()
+
+    entries = []
+    for key, path in collect(args.resources):
+        with open(path, "rb") as f:
+            data = f.read()
+        key_bytes = key.encode("utf-8")
+        entries.append((fnv1a(key_bytes), key_bytes, data))
+    entries.sort(key=lambda e: (e[0], e[1]))
+
+    keys_offset = HEADER.size + ENTRY.size * len(entries)
+    keys_size = sum(len(key) for _, key, _ in entries)
+    offset = keys_offset + keys_size
+
+    table = []
+    key_offset = keys_offset
+    for key_hash, key, data in entries:
+        offset = (offset + ALIGN - 1) // ALIGN * ALIGN
+        table.append(ENTRY.pack(key_hash, offset, len(data), key_offset,
+                                len(key)))
+        key_offset += len(key)
+        offset += len(data)
+
+    tmp_path = args.out + ".tmp"
+    with open(tmp_path, "wb") as out:
+        out.write(HEADER.pack(MAGIC, VERSION, len(entries), 0))
+        out.write(b"".join(table))
+        out.write(b"".join(key for _, key, _ in entries))
+        for _, _, data in entries:
+            out.write(b"\0" * (-out.tell() % ALIGN))
+            out.write(data)
+    os.replace(tmp_path, args.out)
+
+    total = sum(len(data) for _, _, data in entries)
+    print(f"Packed {len(entries)} files ({total / (1 << 20):.1f} MiB) "
+          f"into {args.out}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
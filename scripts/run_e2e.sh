@@ -8,6 +8,8 @@
 #   --timeout <frames>  Set timeout (default: 600)
 #   -w, --width         Screen width (default: 1280)
 #   -h, --height        Screen height (default: 720)
+#   --headless          Hidden window, uncapped frame rate, fixed dt
+#   --jobs <N>          With --all, run scripts in N parallel workers
 
 set -e
 
@@ -21,6 +23,7 @@ SCRIPT_PATH=""
 TIMEOUT=600
 WIDTH=1280
 HEIGHT=720
+EXTRA_ARGS=()
 
 # Parse arguments
 while [[ $# -gt 0 ]]; do
@@ -45,6 +48,14 @@ while [[ $# -gt 0 ]]; do
             HEIGHT="$2"
             shift 2
             ;;
+        --headless)
+            EXTRA_ARGS+=(--headless)
+            shift
+            ;;
+        --jobs)
+            EXTRA_ARGS+=(--jobs "$2")
+            shift 2
+            ;;
         *)
             echo "Unknown option: $1"
             exit 1
@@ -60,12 +71,12 @@ make -j8
 # Run E2E tests
 if [[ -n "$SCRIPT_PATH" ]]; then
     echo "Running E2E script: $SCRIPT_PATH"
-    ./build/ui_tester --test-script "$SCRIPT_PATH" --timeout "$TIMEOUT" -w "$WIDTH" -h "$HEIGHT"
+    ./build/ui_tester --test-script "$SCRIPT_PATH" --timeout "$TIMEOUT" -w "$WIDTH" -h "$HEIGHT" "${EXTRA_ARGS[@]}"
 elif [[ "$RUN_ALL" == true ]]; then
     echo "Running all E2E scripts in $E2E_SCRIPTS_DIR"
-    ./build/ui_tester --test-script-dir "$E2E_SCRIPTS_DIR" --timeout "$TIMEOUT" -w "$WIDTH" -h "$HEIGHT"
+    ./build/ui_tester --test-script-dir "$E2E_SCRIPTS_DIR" --timeout "$TIMEOUT" -w "$WIDTH" -h "$HEIGHT" "${EXTRA_ARGS[@]}"
 else
-    echo "Usage: $0 --script <path> | --all [--timeout <frames>] [-w <width>] [-h <height>]"
+    echo "Usage: $0 --script <path> | --all [--timeout <frames>] [-w <width>] [-h <height>] [--headless] [--jobs <N>]"
     echo ""
     echo "Available E2E scripts:"
     ls -1 "$E2E_SCRIPTS_DIR"/*.e2e 2>/dev/null || echo "  (none found)"
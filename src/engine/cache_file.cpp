@@ -0,0 +1,86 @@
+#include "cache_file.h"
+
+#include "mapped_file.h"
+#include "resource_pack.h"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <system_error>
+
+namespace cache_file {
+
+bool stamp_source(const std::string &path, SourceStamp &out) {
+  // Packed files change only when the pack is rebuilt
+  std::span<const uint8_t> packed = resource_pack::find(path);
+  if (!packed.empty()) {
+    out.size = packed.size();
+    out.mtime = resource_pack::mtime();
+    return true;
+  }
+  std::error_code ec;
+  auto size = std::filesystem::file_size(path, ec);
+  if (ec)
+    return false;
+  auto mtime = std::filesystem::last_write_time(path, ec);
+  if (ec)
+    return false;
+  out.size = static_cast<uint64_t>(size);
+  out.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+  return true;
+}
+
+uint64_t hash_file(const std::string &path) {
+  mapped_file::MappedFile file;
+  if (!resource_pack::open(file, path))
+    return 0;
+  uint64_t hash = 14695981039346656037ull;
+  const uint8_t *bytes = file.data();
+  for (size_t i = 0; i < file.size(); i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+bool source_matches(const std::string &path, const SourceStamp &current,
+                    const SourceStamp &recorded, uint64_t recorded_hash) {
+  if (current.size != recorded.size)
+    return false;
+  if (current.mtime == recorded.mtime)
+    return true;
+  return recorded_hash == hash_file(path);
+}
+
+bool write_atomic(const std::string &path,
+                  std::initializer_list<std::span<const uint8_t>> chunks) {
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path(),
+                                      ec);
+
+  // The suffix is random since parallel e2e workers may race on one entry
+  std::string tmp_path = path + ".tmp" + std::to_string(std::random_device{}());
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+      return false;
+    for (std::span<const uint8_t> chunk : chunks) {
+      out.write(reinterpret_cast<const char *>(chunk.data()),
+                static_cast<std::streamsize>(chunk.size()));
+    }
+    if (!out.good()) {
+      out.close();
+      std::filesystem::remove(tmp_path, ec);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+} // namespace cache_file
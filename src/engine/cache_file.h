@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+
+namespace cache_file {
+
+// Size and mtime of the file a cache entry was derived from
+struct SourceStamp {
+  uint64_t size = 0;
+  int64_t mtime = 0;
+};
+
+bool stamp_source(const std::string &path, SourceStamp &out);
+
+// FNV-1a 64 over the mapped file bytes, 0 if it cannot be read
+uint64_t hash_file(const std::string &path);
+
+// Whether a cache entry recorded for (stamp, hash) still matches the source.
+// A touched but unchanged file (e.g. after a checkout) still matches.
+bool source_matches(const std::string &path, const SourceStamp &current,
+                    const SourceStamp &recorded, uint64_t recorded_hash);
+
+// Writes the chunks to a temp file and renames it over path, so readers
+// (including parallel e2e workers) never see a partial cache entry
+bool write_atomic(const std::string &path,
+                  std::initializer_list<std::span<const uint8_t>> chunks);
+
+template <typename T> std::span<const uint8_t> bytes_of(const T &value) {
+  return {reinterpret_cast<const uint8_t *>(&value), sizeof(T)};
+}
+
+} // namespace cache_file
@@ -0,0 +1,45 @@
+#include "debug_name.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace debug_name {
+
+#ifdef AFTER_HOURS_DEBUG_NAMES
+
+namespace {
+bool g_enabled = true;
+} // namespace
+
+void set_enabled(bool enabled) { g_enabled = enabled; }
+bool enabled() { return g_enabled; }
+
+std::string DebugName::str() const {
+  if (!has_suffix_ || !g_enabled)
+    return prefix_;
+  // Both numbers and the separator between them
+  char digits[48];
+  char *end = std::to_chars(digits, digits + 24, suffix_).ptr;
+  if (has_second_) {
+    *end++ = '_';
+    end = std::to_chars(end, digits + sizeof(digits), second_).ptr;
+  }
+  const size_t prefix_size = std::strlen(prefix_);
+  // One allocation, at most, for the whole name
+  std::string name;
+  name.reserve(prefix_size + static_cast<size_t>(end - digits));
+  name.append(prefix_, prefix_size);
+  name.append(digits, end);
+  return name;
+}
+
+#else
+
+void set_enabled(bool) {}
+bool enabled() { return false; }
+
+std::string DebugName::str() const { return prefix_; }
+
+#endif
+
+} // namespace debug_name
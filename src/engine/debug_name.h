@@ -0,0 +1,61 @@
+#pragma once
+
+#include <concepts>
+#include <string>
+
+// Debug names for immediate-mode elements, e.g. DebugName("kill_", i) in
+// place of "kill_" + std::to_string(i), or DebugName("cell_", row, col) for
+// "cell_<row>_<col>". Only the literal and the numbers are stored; the
+// suffix is formatted when the name is handed to with_debug_name and only
+// while something reads names (the MCP server, e2e focus commands, snapshot
+// tests). Otherwise the element just gets the literal, so names are not
+// unique then: every "kill_" element shares the bare prefix (the screen
+// demo without MCP, or builds with DEBUG_NAMES=0, where the suffix is
+// dropped at compile time). Do not key anything on them in those runs.
+namespace debug_name {
+
+// On by default; the screen demo turns it off unless MCP is driving it
+void set_enabled(bool enabled);
+bool enabled();
+
+class DebugName {
+public:
+  constexpr DebugName(const char *prefix) : prefix_(prefix) {}
+
+  template <std::integral T>
+  constexpr DebugName(const char *prefix, T suffix) : prefix_(prefix) {
+#ifdef AFTER_HOURS_DEBUG_NAMES
+    suffix_ = static_cast<long long>(suffix);
+    has_suffix_ = true;
+#else
+    (void)suffix;
+#endif
+  }
+
+  template <std::integral T, std::integral U>
+  constexpr DebugName(const char *prefix, T first, U second)
+      : DebugName(prefix, first) {
+#ifdef AFTER_HOURS_DEBUG_NAMES
+    second_ = static_cast<long long>(second);
+    has_second_ = true;
+#else
+    (void)second;
+#endif
+  }
+
+  std::string str() const;
+  operator std::string() const { return str(); }
+
+private:
+  const char *prefix_;
+#ifdef AFTER_HOURS_DEBUG_NAMES
+  long long suffix_ = 0;
+  long long second_ = 0;
+  bool has_suffix_ = false;
+  bool has_second_ = false;
+#endif
+};
+
+} // namespace debug_name
+
+using debug_name::DebugName;
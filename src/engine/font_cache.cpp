@@ -0,0 +1,331 @@
+#include "font_cache.h"
+
+#include "../log.h"
+#include "cache_file.h"
+#include "mapped_file.h"
+#include "resource_pack.h"
+
+#include <afterhours/src/plugins/files.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace font_cache {
+
+namespace {
+
+constexpr char kMagic[4] = {'A', 'H', 'F', 'C'};
+constexpr uint32_t kVersion = 1;
+// raylib's FONT_TTF_DEFAULT_CHARS_PADDING
+constexpr int GLYPH_PADDING = 4;
+
+// On-disk header, followed by glyph_count GlyphRecords, glyph_count recs and
+// the atlas pixels at their offsets
+struct CacheHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t source_size;
+  int64_t source_mtime;
+  uint64_t source_hash;
+  uint64_t codepoints_hash;
+  int32_t font_size;
+  int32_t glyph_count;
+  int32_t glyph_padding;
+  int32_t atlas_width;
+  int32_t atlas_height;
+  int32_t atlas_format;
+  uint32_t glyphs_offset;
+  uint32_t recs_offset;
+  uint32_t pixels_offset;
+  uint32_t reserved;
+};
+
+struct GlyphRecord {
+  int32_t value;
+  int32_t offset_x;
+  int32_t offset_y;
+  int32_t advance_x;
+};
+
+std::vector<int> resolve_codepoints(const int *codepoints, int count) {
+  if (codepoints != nullptr && count > 0)
+    return std::vector<int>(codepoints, codepoints + count);
+  std::vector<int> ascii;
+  for (int codepoint = 32; codepoint < 127; codepoint++) {
+    ascii.push_back(codepoint);
+  }
+  return ascii;
+}
+
+uint64_t hash_codepoints(const std::vector<int> &codepoints) {
+  uint64_t hash = 14695981039346656037ull;
+  for (int codepoint : codepoints) {
+    hash ^= static_cast<uint64_t>(static_cast<uint32_t>(codepoint));
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+size_t atlas_bytes(int width, int height, int format) {
+  return static_cast<size_t>(raylib::GetPixelDataSize(width, height, format));
+}
+
+const CacheHeader *read_header(const mapped_file::MappedFile &file,
+                               int font_size, uint64_t codepoints_hash,
+                               int glyph_count) {
+  if (file.size() < sizeof(CacheHeader))
+    return nullptr;
+  const auto *header = reinterpret_cast<const CacheHeader *>(file.data());
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion || header->font_size != font_size ||
+      header->codepoints_hash != codepoints_hash ||
+      header->glyph_count != glyph_count || header->atlas_width <= 0 ||
+      header->atlas_height <= 0)
+    return nullptr;
+  const size_t count = static_cast<size_t>(glyph_count);
+  if (header->glyphs_offset + count * sizeof(GlyphRecord) > file.size() ||
+      header->recs_offset + count * sizeof(raylib::Rectangle) > file.size() ||
+      header->pixels_offset + atlas_bytes(header->atlas_width,
+                                          header->atlas_height,
+                                          header->atlas_format) >
+          file.size())
+    return nullptr;
+  return header;
+}
+
+// Copies the metrics out of the cache; the atlas keeps pointing into it
+void read_cache(const mapped_file::MappedFile &file, const CacheHeader &header,
+                raylib::Font &font, raylib::Image &atlas) {
+  const size_t count = static_cast<size_t>(header.glyph_count);
+  font.baseSize = header.font_size;
+  font.glyphCount = header.glyph_count;
+  font.glyphPadding = header.glyph_padding;
+
+  font.recs = static_cast<raylib::Rectangle *>(raylib::MemAlloc(
+      static_cast<unsigned int>(count * sizeof(raylib::Rectangle))));
+  std::memcpy(font.recs, file.data() + header.recs_offset,
+              count * sizeof(raylib::Rectangle));
+
+  font.glyphs = static_cast<raylib::GlyphInfo *>(raylib::MemAlloc(
+      static_cast<unsigned int>(count * sizeof(raylib::GlyphInfo))));
+  const auto *records = reinterpret_cast<const GlyphRecord *>(
+      file.data() + header.glyphs_offset);
+  for (size_t i = 0; i < count; i++) {
+    font.glyphs[i] = raylib::GlyphInfo{};
+    font.glyphs[i].value = records[i].value;
+    font.glyphs[i].offsetX = records[i].offset_x;
+    font.glyphs[i].offsetY = records[i].offset_y;
+    font.glyphs[i].advanceX = records[i].advance_x;
+  }
+
+  atlas.data = const_cast<uint8_t *>(file.data() + header.pixels_offset);
+  atlas.width = header.atlas_width;
+  atlas.height = header.atlas_height;
+  atlas.mipmaps = 1;
+  atlas.format = header.atlas_format;
+}
+
+bool write_cache(const std::string &cache_path,
+                 const cache_file::SourceStamp &source, uint64_t source_hash,
+                 uint64_t codepoints_hash, const raylib::Font &font,
+                 const raylib::Image &atlas) {
+  const size_t count = static_cast<size_t>(font.glyphCount);
+  std::vector<GlyphRecord> records(count);
+  for (size_t i = 0; i < count; i++) {
+    const raylib::GlyphInfo &glyph = font.glyphs[i];
+    records[i] = GlyphRecord{glyph.value, glyph.offsetX, glyph.offsetY,
+                             glyph.advanceX};
+  }
+  const size_t records_bytes = count * sizeof(GlyphRecord);
+  const size_t recs_bytes = count * sizeof(raylib::Rectangle);
+
+  CacheHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.source_size = source.size;
+  header.source_mtime = source.mtime;
+  header.source_hash = source_hash;
+  header.codepoints_hash = codepoints_hash;
+  header.font_size = font.baseSize;
+  header.glyph_count = font.glyphCount;
+  header.glyph_padding = font.glyphPadding;
+  header.atlas_width = atlas.width;
+  header.atlas_height = atlas.height;
+  header.atlas_format = atlas.format;
+  header.glyphs_offset = static_cast<uint32_t>(sizeof(CacheHeader));
+  header.recs_offset = static_cast<uint32_t>(sizeof(CacheHeader) +
+                                             records_bytes);
+  header.pixels_offset = static_cast<uint32_t>(sizeof(CacheHeader) +
+                                               records_bytes + recs_bytes);
+
+  return cache_file::write_atomic(
+      cache_path,
+      {cache_file::bytes_of(header),
+       {reinterpret_cast<const uint8_t *>(records.data()), records_bytes},
+       {reinterpret_cast<const uint8_t *>(font.recs), recs_bytes},
+       {static_cast<const uint8_t *>(atlas.data),
+        atlas_bytes(atlas.width, atlas.height, atlas.format)}});
+}
+
+} // namespace
+
+uint64_t codepoints_hash(const int *codepoints, int codepoint_count) {
+  return hash_codepoints(resolve_codepoints(codepoints, codepoint_count));
+}
+
+std::string cache_path_for(const std::string &font_path, int font_size,
+                           const int *codepoints, int codepoint_count) {
+  std::filesystem::path font(font_path);
+  char key[32];
+  std::snprintf(key, sizeof(key), "-%d-%016llx", font_size,
+                static_cast<unsigned long long>(
+                    codepoints_hash(codepoints, codepoint_count)));
+  // Under the save dir, resources/ may be read-only or only ship as a pack
+  return (afterhours::files::get_save_path() / "font_cache" / font.stem())
+             .string() +
+         key + ".font";
+}
+
+BakedFont::~BakedFont() { reset(); }
+
+BakedFont::BakedFont(BakedFont &&other) noexcept
+    : font_(other.font_), atlas_(other.atlas_),
+      cache_(std::move(other.cache_)) {
+  other.font_ = raylib::Font{};
+  other.atlas_ = raylib::Image{};
+}
+
+BakedFont &BakedFont::operator=(BakedFont &&other) noexcept {
+  if (this != &other) {
+    reset();
+    font_ = other.font_;
+    atlas_ = other.atlas_;
+    cache_ = std::move(other.cache_);
+    other.font_ = raylib::Font{};
+    other.atlas_ = raylib::Image{};
+  }
+  return *this;
+}
+
+void BakedFont::reset() {
+  raylib::MemFree(font_.glyphs);
+  raylib::MemFree(font_.recs);
+  font_ = raylib::Font{};
+  if (!cache_.is_open() && atlas_.data != nullptr) {
+    raylib::UnloadImage(atlas_);
+  }
+  atlas_ = raylib::Image{};
+  cache_.close();
+}
+
+BakedFont bake(const std::string &font_path, int font_size,
+               const int *codepoints, int codepoint_count) {
+  BakedFont baked;
+  std::vector<int> resolved = resolve_codepoints(codepoints, codepoint_count);
+  const uint64_t codepoints_hash = hash_codepoints(resolved);
+  const int glyph_count = static_cast<int>(resolved.size());
+  const std::string cache_path =
+      cache_path_for(font_path, font_size, codepoints, codepoint_count);
+
+  cache_file::SourceStamp source;
+  if (!cache_file::stamp_source(font_path, source)) {
+    log_warn("[font_cache] Missing font {}", font_path);
+    return baked;
+  }
+
+  {
+    mapped_file::MappedFile cache;
+    if (cache.open(cache_path)) {
+      const CacheHeader *header =
+          read_header(cache, font_size, codepoints_hash, glyph_count);
+      if (header &&
+          cache_file::source_matches(
+              font_path, source,
+              cache_file::SourceStamp{header->source_size,
+                                      header->source_mtime},
+              header->source_hash)) {
+        read_cache(cache, *header, baked.font_, baked.atlas_);
+        baked.cache_ = std::move(cache);
+        return baked;
+      }
+    }
+  }
+
+  // Cache missing or stale: bake the atlas the way LoadFontEx does
+  mapped_file::MappedFile file;
+  if (!resource_pack::open(file, font_path)) {
+    log_warn("[font_cache] Could not read font {}", font_path);
+    return baked;
+  }
+  raylib::Font &font = baked.font_;
+  font.baseSize = font_size;
+  font.glyphCount = glyph_count;
+  font.glyphPadding = GLYPH_PADDING;
+  font.glyphs = raylib::LoadFontData(file.data(), static_cast<int>(file.size()),
+                                     font_size, resolved.data(), glyph_count,
+                                     raylib::FONT_DEFAULT);
+  if (font.glyphs == nullptr) {
+    log_warn("[font_cache] Could not rasterize font {}", font_path);
+    return baked;
+  }
+  baked.atlas_ = raylib::GenImageFontAtlas(
+      font.glyphs, &font.recs, glyph_count, font_size, GLYPH_PADDING, 0);
+
+  // Cached fonts carry no per-glyph images, drop them here too so both paths
+  // behave the same
+  for (int i = 0; i < glyph_count; i++) {
+    raylib::UnloadImage(font.glyphs[i].image);
+    font.glyphs[i].image = raylib::Image{};
+  }
+
+  if (!write_cache(cache_path, source, cache_file::hash_file(font_path),
+                   codepoints_hash, font, baked.atlas_)) {
+    log_warn("[font_cache] Could not write cache for {}", font_path);
+  }
+  return baked;
+}
+
+raylib::Font upload(const BakedFont &baked) {
+  if (!baked.ok()) {
+    return raylib::GetFontDefault();
+  }
+  // Each upload owns its metrics so one bake can back several fonts
+  const size_t count = static_cast<size_t>(baked.font_.glyphCount);
+  raylib::Font font = baked.font_;
+  font.recs = static_cast<raylib::Rectangle *>(raylib::MemAlloc(
+      static_cast<unsigned int>(count * sizeof(raylib::Rectangle))));
+  std::memcpy(font.recs, baked.font_.recs, count * sizeof(raylib::Rectangle));
+  font.glyphs = static_cast<raylib::GlyphInfo *>(raylib::MemAlloc(
+      static_cast<unsigned int>(count * sizeof(raylib::GlyphInfo))));
+  std::memcpy(font.glyphs, baked.font_.glyphs,
+              count * sizeof(raylib::GlyphInfo));
+  // A cache hit uploads straight from the mapping, the pixels are never
+  // copied
+  font.texture = raylib::LoadTextureFromImage(baked.atlas_);
+  return font;
+}
+
+raylib::Font load(const std::string &font_path, int font_size,
+                  const int *codepoints, int codepoint_count) {
+  BakedFont baked = bake(font_path, font_size, codepoints, codepoint_count);
+  return upload(baked);
+}
+
+BakedFont bake_ui_font(const std::string &font_path) {
+  return bake(font_path, UI_FONT_SIZE);
+}
+
+raylib::Font upload_ui_font(const BakedFont &baked) {
+  raylib::Font font = upload(baked);
+  raylib::GenTextureMipmaps(&font.texture);
+  raylib::SetTextureFilter(font.texture, raylib::TEXTURE_FILTER_POINT);
+  return font;
+}
+
+raylib::Font load_from_file(const std::string &font_path) {
+  BakedFont baked = bake_ui_font(font_path);
+  return upload_ui_font(baked);
+}
+
+} // namespace font_cache
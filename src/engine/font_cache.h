@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../rl.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <string>
+
+namespace font_cache {
+
+// Size afterhours::load_font_from_file bakes UI fonts at
+constexpr int UI_FONT_SIZE = 400;
+
+// Identifies a codepoint set, nullptr means printable ASCII
+uint64_t codepoints_hash(const int *codepoints, int codepoint_count);
+
+// Cache file for a font baked at font_size with these codepoints:
+// <save dir>/font_cache/<name>-<size>-<codepoint set hash>.font
+std::string cache_path_for(const std::string &font_path, int font_size,
+                           const int *codepoints, int codepoint_count);
+
+// A font rasterized (or read back from the cache) but not yet on the GPU.
+// Baking only touches the CPU, so it is safe on worker threads; upload()
+// must run on the thread that owns the GL context.
+class BakedFont {
+public:
+  BakedFont() = default;
+  ~BakedFont();
+
+  BakedFont(const BakedFont &) = delete;
+  BakedFont &operator=(const BakedFont &) = delete;
+  BakedFont(BakedFont &&other) noexcept;
+  BakedFont &operator=(BakedFont &&other) noexcept;
+
+  bool ok() const { return font_.glyphs != nullptr; }
+
+private:
+  void reset();
+
+  friend BakedFont bake(const std::string &, int, const int *, int);
+  friend raylib::Font upload(const BakedFont &);
+
+  raylib::Font font_{};
+  raylib::Image atlas_{};
+  // Set when atlas_ points into the cache mapping rather than owned memory
+  mapped_file::MappedFile cache_;
+};
+
+// CPU half of load(): maps the cache or rasterizes and writes it
+BakedFont bake(const std::string &font_path, int font_size,
+               const int *codepoints = nullptr, int codepoint_count = 0);
+// GPU half of load(): uploads the atlas into a new font. Can be called more
+// than once per bake. Returns the default font if baking failed.
+raylib::Font upload(const BakedFont &baked);
+
+// Equivalent of raylib::LoadFontEx that stores the baked atlas and glyph
+// metrics on disk. Later calls map the cache and upload the atlas instead
+// of rasterizing, until the font file changes. codepoints == nullptr means
+// the 95 printable ASCII characters, like raylib.
+raylib::Font load(const std::string &font_path, int font_size,
+                  const int *codepoints = nullptr, int codepoint_count = 0);
+
+// Cached equivalent of afterhours::load_font_from_file, split so the bake
+// can run off the main thread
+BakedFont bake_ui_font(const std::string &font_path);
+raylib::Font upload_ui_font(const BakedFont &baked);
+raylib::Font load_from_file(const std::string &font_path);
+
+} // namespace font_cache
@@ -0,0 +1,134 @@
+#include "font_registry.h"
+
+#include "font_cache.h"
+#include "glyph_atlas.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+
+namespace font_registry {
+
+namespace {
+
+struct Entry {
+  Key key;
+  raylib::Font font{};
+  std::vector<std::string> names;
+};
+
+// Few fonts, so a vector beats hashing paths. Entries are never removed,
+// so returned references stay valid.
+std::vector<std::unique_ptr<Entry>> &entries() {
+  static std::vector<std::unique_ptr<Entry>> registered;
+  return registered;
+}
+
+Entry *find_entry(const Key &key) {
+  for (auto &entry : entries()) {
+    if (entry->key == key)
+      return entry.get();
+  }
+  return nullptr;
+}
+
+size_t texture_bytes(const raylib::Texture2D &texture) {
+  size_t bytes = 0;
+  int width = texture.width;
+  int height = texture.height;
+  for (int level = 0; level < std::max(1, texture.mipmaps); level++) {
+    bytes += static_cast<size_t>(
+        raylib::GetPixelDataSize(width, height, texture.format));
+    width = std::max(1, width / 2);
+    height = std::max(1, height / 2);
+  }
+  return bytes;
+}
+
+} // namespace
+
+Key ui_font_key(const std::string &path) {
+  return Key{path, font_cache::UI_FONT_SIZE,
+             font_cache::codepoints_hash(nullptr, 0)};
+}
+
+const raylib::Font *find(const Key &key) {
+  Entry *entry = find_entry(key);
+  return entry ? &entry->font : nullptr;
+}
+
+const raylib::Font &add(const Key &key, const raylib::Font &font) {
+  if (Entry *existing = find_entry(key)) {
+    if (font.texture.id != existing->font.texture.id) {
+      raylib::UnloadFont(font);
+    }
+    return existing->font;
+  }
+  auto entry = std::make_unique<Entry>();
+  entry->key = key;
+  entry->font = font;
+  entries().push_back(std::move(entry));
+  return entries().back()->font;
+}
+
+void alias(const std::string &name, const Key &key) {
+  Entry *entry = find_entry(key);
+  if (entry && std::find(entry->names.begin(), entry->names.end(), name) ==
+                   entry->names.end()) {
+    entry->names.push_back(name);
+  }
+}
+
+const raylib::Font &load_ui_font(const std::string &path) {
+  Key key = ui_font_key(path);
+  if (const raylib::Font *font = find(key))
+    return *font;
+  return add(key, font_cache::load_from_file(path));
+}
+
+std::vector<Usage> usage() {
+  std::vector<Usage> result;
+  for (const auto &entry : entries()) {
+    result.push_back(
+        Usage{entry->key, entry->names, texture_bytes(entry->font.texture)});
+  }
+  return result;
+}
+
+size_t resident_bytes() {
+  size_t total = glyph_atlas::resident_bytes();
+  for (const Usage &font : usage()) {
+    total += font.texture_bytes;
+  }
+  return total;
+}
+
+void print_report(std::ostream &out) {
+  char line[256];
+  out << "Font textures:\n";
+  for (const Usage &font : usage()) {
+    std::string names;
+    for (const std::string &name : font.names) {
+      names += (names.empty() ? "" : ", ") + name;
+    }
+    std::string file =
+        std::filesystem::path(font.key.path).filename().string();
+    std::snprintf(line, sizeof(line), "  %-36s %4dpx %9.1f KiB  %s\n",
+                  file.c_str(), font.key.size,
+                  static_cast<double>(font.texture_bytes) / 1024.0,
+                  names.c_str());
+    out << line;
+  }
+  for (const auto &[name, bytes] : glyph_atlas::resident_by_font()) {
+    std::snprintf(line, sizeof(line), "  %-36s %6s %9.1f KiB  %s\n",
+                  "(dynamic atlas)", "", static_cast<double>(bytes) / 1024.0,
+                  name.c_str());
+    out << line;
+  }
+  std::snprintf(line, sizeof(line), "  total %.1f KiB\n",
+                static_cast<double>(resident_bytes()) / 1024.0);
+  out << line;
+}
+
+} // namespace font_registry
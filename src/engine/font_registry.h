@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../rl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace font_registry {
+
+// What makes two baked fonts identical: file, pixel size and codepoint set
+struct Key {
+  std::string path;
+  int size = 0;
+  uint64_t codepoints = 0;
+
+  bool operator==(const Key &other) const = default;
+};
+
+// Key for a font_cache::load_from_file style UI font
+Key ui_font_key(const std::string &path);
+
+// The font already loaded for key, or nullptr
+const raylib::Font *find(const Key &key);
+// Stores a loaded font for key and returns the registered copy. If key is
+// already resident the new font is unloaded and the existing one returned.
+const raylib::Font &add(const Key &key, const raylib::Font &font);
+// Records a FontManager name that refers to key's font, for the report
+void alias(const std::string &name, const Key &key);
+
+// Cached, deduplicated equivalent of font_cache::load_from_file
+const raylib::Font &load_ui_font(const std::string &path);
+
+struct Usage {
+  Key key;
+  std::vector<std::string> names;
+  size_t texture_bytes = 0;
+};
+std::vector<Usage> usage();
+// Static atlases plus dynamic glyph atlases
+size_t resident_bytes();
+void print_report(std::ostream &out);
+
+} // namespace font_registry
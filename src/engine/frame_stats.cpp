@@ -0,0 +1,179 @@
+#include "frame_stats.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace frame_stats {
+
+namespace {
+
+struct Series {
+  const char *name;
+  uint64_t start_ns = 0;
+  uint64_t total_ns = 0;
+  std::array<float, WINDOW> ms{};
+};
+
+struct State {
+  bool enabled = false;
+  std::vector<Series> series;
+  std::array<float, WINDOW> frame_ms{};
+  // Ring position of the next frame and how many are filled
+  size_t head = 0;
+  size_t count = 0;
+  uint64_t last_frame_ns = 0;
+};
+
+State &state() {
+  static State instance;
+  return instance;
+}
+
+uint64_t now_ns() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+float to_ms(uint64_t ns) { return static_cast<float>(ns) / 1e6f; }
+
+// Ring index of the i-th oldest frame
+size_t ring_index(const State &s, size_t i) {
+  return (s.head + WINDOW - s.count + i) % WINDOW;
+}
+
+// Nearest rank on an already sorted window
+float percentile(const std::vector<float> &sorted, float p) {
+  size_t rank = static_cast<size_t>(
+      std::ceil(p * static_cast<float>(sorted.size())));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+} // namespace
+
+Slot slot(const char *name) {
+  State &s = state();
+  for (size_t i = 0; i < s.series.size(); i++) {
+    if (std::strcmp(s.series[i].name, name) == 0)
+      return i;
+  }
+  s.series.push_back(Series{name});
+  return s.series.size() - 1;
+}
+
+void set_enabled(bool enabled) {
+  State &s = state();
+  if (enabled && !s.enabled) {
+    s.head = 0;
+    s.count = 0;
+    s.last_frame_ns = 0;
+    for (Series &series : s.series) {
+      series.start_ns = 0;
+      series.total_ns = 0;
+    }
+  }
+  s.enabled = enabled;
+}
+
+bool enabled() { return state().enabled; }
+
+void begin(Slot slot) {
+  State &s = state();
+  if (s.enabled)
+    s.series[slot].start_ns = now_ns();
+}
+
+void end(Slot slot) {
+  State &s = state();
+  Series &series = s.series[slot];
+  // A begin from before the HUD was opened leaves start_ns at 0
+  if (!s.enabled || series.start_ns == 0)
+    return;
+  series.total_ns += now_ns() - series.start_ns;
+  series.start_ns = 0;
+}
+
+void end_frame() {
+  State &s = state();
+  if (!s.enabled)
+    return;
+  const uint64_t now = now_ns();
+  // The first frame after enabling has no start to measure from
+  if (s.last_frame_ns != 0) {
+    s.frame_ms[s.head] = to_ms(now - s.last_frame_ns);
+    for (Series &series : s.series) {
+      series.ms[s.head] = to_ms(series.total_ns);
+    }
+    s.head = (s.head + 1) % WINDOW;
+    s.count = std::min(s.count + 1, WINDOW);
+  }
+  for (Series &series : s.series) {
+    series.total_ns = 0;
+  }
+  s.last_frame_ns = now;
+}
+
+Percentiles frame_percentiles() {
+  std::vector<float> sorted = frame_history();
+  if (sorted.empty())
+    return {};
+  std::sort(sorted.begin(), sorted.end());
+  return {percentile(sorted, 0.50f), percentile(sorted, 0.95f),
+          percentile(sorted, 0.99f), sorted.back()};
+}
+
+std::vector<float> frame_history() {
+  const State &s = state();
+  std::vector<float> history(s.count);
+  for (size_t i = 0; i < s.count; i++) {
+    history[i] = s.frame_ms[ring_index(s, i)];
+  }
+  return history;
+}
+
+std::vector<SystemTime> system_times() {
+  const State &s = state();
+  std::vector<SystemTime> times;
+  times.reserve(s.series.size());
+  for (const Series &series : s.series) {
+    SystemTime time{series.name, 0.f, 0.f};
+    if (s.count > 0) {
+      float sum = 0.f;
+      for (size_t i = 0; i < s.count; i++) {
+        sum += series.ms[ring_index(s, i)];
+      }
+      time.last_ms = series.ms[ring_index(s, s.count - 1)];
+      time.mean_ms = sum / static_cast<float>(s.count);
+    }
+    times.push_back(time);
+  }
+  return times;
+}
+
+bool write_csv(const std::string &path) {
+  const State &s = state();
+  std::ofstream out(path);
+  if (!out)
+    return false;
+  out << "frame,frame_ms";
+  for (const Series &series : s.series) {
+    out << ',' << series.name;
+  }
+  out << '\n';
+  for (size_t i = 0; i < s.count; i++) {
+    const size_t index = ring_index(s, i);
+    out << i << ',' << s.frame_ms[index];
+    for (const Series &series : s.series) {
+      out << ',' << series.ms[index];
+    }
+    out << '\n';
+  }
+  return static_cast<bool>(out);
+}
+
+} // namespace frame_stats
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Rolling per-frame timings for the perf HUD (RenderUIDebug). Systems are
+// timed through TracedSystem, see traced(). Main thread only; nothing is
+// recorded unless enabled.
+namespace frame_stats {
+
+// Frames kept for the graph, the percentiles and the CSV dump
+constexpr size_t WINDOW = 300;
+
+using Slot = size_t;
+
+// One slot per distinct name; registering the same name again returns the
+// existing slot
+Slot slot(const char *name);
+
+// Enabling starts a fresh window
+void set_enabled(bool enabled);
+bool enabled();
+
+// Time between begin and end is added to the slot's total for this frame
+void begin(Slot slot);
+void end(Slot slot);
+
+// Closes the frame: records the time since the previous call and each
+// slot's total
+void end_frame();
+
+struct Percentiles {
+  float p50 = 0.f;
+  float p95 = 0.f;
+  float p99 = 0.f;
+  float max = 0.f;
+};
+
+// Over the frames currently in the window, in milliseconds
+Percentiles frame_percentiles();
+
+// Frame times in milliseconds, oldest first
+std::vector<float> frame_history();
+
+struct SystemTime {
+  const char *name;
+  float last_ms;
+  float mean_ms;
+};
+
+// Every slot in registration order
+std::vector<SystemTime> system_times();
+
+// One row per frame in the window: frame time, then each slot
+bool write_csv(const std::string &path);
+
+} // namespace frame_stats
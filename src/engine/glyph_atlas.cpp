@@ -0,0 +1,390 @@
+#include "glyph_atlas.h"
+
+#include "../log.h"
+#include "resource_pack.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace glyph_atlas {
+
+namespace {
+
+// Same padding raylib uses for LoadFontEx atlases
+constexpr int GLYPH_PADDING = 4;
+// Conservative GL_MAX_TEXTURE_SIZE that every desktop driver supports
+constexpr int MAX_TEXTURE_HEIGHT = 8192;
+constexpr int BYTES_PER_PIXEL = 2; // gray + alpha, like raylib font atlases
+
+struct Entry {
+  std::string name;
+  std::unique_ptr<DynamicFont> font;
+};
+
+std::vector<Entry> &registry() {
+  static std::vector<Entry> entries;
+  return entries;
+}
+
+uint64_t current_frame = 0;
+
+// Decodes one UTF-8 sequence, returning the codepoint or -1 for bad bytes
+int next_codepoint(std::string_view text, size_t &i) {
+  unsigned char lead = static_cast<unsigned char>(text[i++]);
+  int length = 0;
+  int codepoint = 0;
+  if ((lead & 0xE0) == 0xC0) {
+    length = 1;
+    codepoint = lead & 0x1F;
+  } else if ((lead & 0xF0) == 0xE0) {
+    length = 2;
+    codepoint = lead & 0x0F;
+  } else if ((lead & 0xF8) == 0xF0) {
+    length = 3;
+    codepoint = lead & 0x07;
+  } else {
+    return -1;
+  }
+  for (int n = 0; n < length; n++) {
+    if (i >= text.size())
+      return -1;
+    unsigned char c = static_cast<unsigned char>(text[i]);
+    if ((c & 0xC0) != 0x80)
+      return -1;
+    codepoint = (codepoint << 6) | (c & 0x3F);
+    i++;
+  }
+  return codepoint;
+}
+
+} // namespace
+
+void SlotTable::reserve(int capacity) {
+  if (capacity > this->capacity()) {
+    slots_.resize(static_cast<size_t>(capacity));
+  }
+}
+
+int SlotTable::find(int codepoint) const {
+  auto it = index_.find(codepoint);
+  return it == index_.end() ? -1 : it->second;
+}
+
+int SlotTable::allocate(int codepoint, uint64_t frame, bool pinned) {
+  if (used_ >= capacity())
+    return -1;
+  int slot = used_++;
+  slots_[slot] = Slot{codepoint, frame, pinned};
+  index_[codepoint] = slot;
+  return slot;
+}
+
+int SlotTable::evict(int codepoint, uint64_t frame, int &evicted) {
+  int best = -1;
+  for (int i = 0; i < used_; i++) {
+    const Slot &slot = slots_[i];
+    if (slot.pinned || slot.last_used >= frame)
+      continue;
+    if (best < 0 || slot.last_used < slots_[best].last_used) {
+      best = i;
+    }
+  }
+  if (best < 0)
+    return -1;
+
+  evicted = slots_[best].codepoint;
+  index_.erase(evicted);
+  slots_[best] = Slot{codepoint, frame, false};
+  index_[codepoint] = best;
+  return best;
+}
+
+DynamicFont::~DynamicFont() { unload(); }
+
+bool DynamicFont::open(const std::string &path, const Config &config) {
+  unload();
+  config_ = config;
+
+  if (!resource_pack::open(file_, path)) {
+    log_error("[glyph_atlas] Could not read font {}", path);
+    return false;
+  }
+
+  cell_size_ = config_.base_size + 2 * GLYPH_PADDING;
+  cells_per_row_ = std::max(1, config_.page_size / cell_size_);
+  const size_t page_bytes = static_cast<size_t>(config_.page_size) *
+                            static_cast<size_t>(config_.page_size) *
+                            BYTES_PER_PIXEL;
+  max_pages_ = static_cast<int>(std::clamp<size_t>(
+      config_.memory_budget / page_bytes, 1,
+      static_cast<size_t>(MAX_TEXTURE_HEIGHT / config_.page_size)));
+
+  // Sized for the largest atlas up front so the arrays never move
+  const int max_glyphs = max_pages_ * cells_per_row_ * cells_per_row_;
+  font_.baseSize = config_.base_size;
+  font_.glyphPadding = GLYPH_PADDING;
+  font_.recs = static_cast<raylib::Rectangle *>(raylib::MemAlloc(
+      static_cast<unsigned int>(max_glyphs * sizeof(raylib::Rectangle))));
+  font_.glyphs = static_cast<raylib::GlyphInfo *>(raylib::MemAlloc(
+      static_cast<unsigned int>(max_glyphs * sizeof(raylib::GlyphInfo))));
+
+  if (!grow()) {
+    unload();
+    return false;
+  }
+
+  for (int codepoint = 0x20; codepoint < 0x7F; codepoint++) {
+    queued_.emplace_back(codepoint, true);
+    queued_set_.insert(codepoint);
+  }
+  flush(0);
+  return true;
+}
+
+void DynamicFont::unload() {
+  if (font_.texture.id != 0) {
+    raylib::UnloadTexture(font_.texture);
+  }
+  raylib::MemFree(font_.recs);
+  raylib::MemFree(font_.glyphs);
+  font_ = raylib::Font{};
+  file_.close();
+  slots_ = SlotTable{};
+  pages_ = 0;
+  queued_.clear();
+  queued_set_.clear();
+  missing_.clear();
+}
+
+size_t DynamicFont::texture_bytes() const {
+  return static_cast<size_t>(config_.page_size) *
+         static_cast<size_t>(config_.page_size) * BYTES_PER_PIXEL *
+         static_cast<size_t>(pages_);
+}
+
+bool DynamicFont::wanted(int codepoint) const {
+  if (codepoint < 0x20)
+    return false;
+  if (codepoint < 0x80 || config_.ranges.empty())
+    return true;
+  return std::any_of(config_.ranges.begin(), config_.ranges.end(),
+                     [codepoint](const std::pair<int, int> &range) {
+                       return codepoint >= range.first &&
+                              codepoint <= range.second;
+                     });
+}
+
+void DynamicFont::request(int codepoint, uint64_t frame) {
+  int slot = slots_.find(codepoint);
+  if (slot >= 0) {
+    slots_.touch(slot, frame);
+    return;
+  }
+  if (!wanted(codepoint) || missing_.contains(codepoint) ||
+      !queued_set_.insert(codepoint).second)
+    return;
+  queued_.emplace_back(codepoint, false);
+}
+
+bool DynamicFont::grow() {
+  if (pages_ >= max_pages_)
+    return false;
+
+  const int width = config_.page_size;
+  const int height = (pages_ + 1) * config_.page_size;
+  const size_t row_bytes = static_cast<size_t>(width) * BYTES_PER_PIXEL;
+  raylib::Image atlas{};
+  atlas.data = raylib::MemAlloc(
+      static_cast<unsigned int>(row_bytes * static_cast<size_t>(height)));
+  atlas.width = width;
+  atlas.height = height;
+  atlas.mipmaps = 1;
+  atlas.format = raylib::PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA;
+
+  // Pages are stacked vertically, so the old atlas is a prefix of the new one
+  if (font_.texture.id != 0) {
+    raylib::Image old = raylib::LoadImageFromTexture(font_.texture);
+    if (old.data != nullptr) {
+      raylib::ImageFormat(&old, raylib::PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA);
+      std::memcpy(atlas.data, old.data,
+                  row_bytes * static_cast<size_t>(old.height));
+      raylib::UnloadImage(old);
+    }
+    raylib::UnloadTexture(font_.texture);
+  }
+
+  font_.texture = raylib::LoadTextureFromImage(atlas);
+  raylib::UnloadImage(atlas);
+  if (font_.texture.id == 0)
+    return false;
+  raylib::SetTextureFilter(font_.texture, raylib::TEXTURE_FILTER_BILINEAR);
+
+  pages_++;
+  slots_.reserve(pages_ * cells_per_row_ * cells_per_row_);
+  return true;
+}
+
+raylib::Rectangle DynamicFont::cell_rect(int slot) const {
+  const int cells_per_page = cells_per_row_ * cells_per_row_;
+  const int page = slot / cells_per_page;
+  const int index = slot % cells_per_page;
+  return raylib::Rectangle{
+      static_cast<float>((index % cells_per_row_) * cell_size_),
+      static_cast<float>(page * config_.page_size +
+                         (index / cells_per_row_) * cell_size_),
+      static_cast<float>(cell_size_), static_cast<float>(cell_size_)};
+}
+
+void DynamicFont::upload(int slot, const raylib::GlyphInfo &glyph) {
+  const int max_extent = cell_size_ - 2 * GLYPH_PADDING;
+  const raylib::Image &image = glyph.image;
+  const int width = std::min(image.width, max_extent);
+  const int height = std::min(image.height, max_extent);
+
+  // The whole cell is rewritten so an evicted glyph leaves nothing behind
+  std::vector<uint8_t> cell(static_cast<size_t>(cell_size_) *
+                                static_cast<size_t>(cell_size_) *
+                                BYTES_PER_PIXEL,
+                            0);
+  const auto *src = static_cast<const uint8_t *>(image.data);
+  for (int y = 0; src && y < height; y++) {
+    uint8_t *dst =
+        &cell[(static_cast<size_t>(y + GLYPH_PADDING) * cell_size_ +
+               GLYPH_PADDING) *
+              BYTES_PER_PIXEL];
+    const uint8_t *row = src + static_cast<size_t>(y) * image.width;
+    for (int x = 0; x < width; x++) {
+      dst[x * 2] = 255;
+      dst[x * 2 + 1] = row[x];
+    }
+  }
+
+  raylib::Rectangle rect = cell_rect(slot);
+  raylib::UpdateTextureRec(font_.texture, rect, cell.data());
+
+  font_.recs[slot] = raylib::Rectangle{
+      rect.x + GLYPH_PADDING, rect.y + GLYPH_PADDING,
+      static_cast<float>(std::max(width, 0)),
+      static_cast<float>(std::max(height, 0))};
+  raylib::GlyphInfo &info = font_.glyphs[slot];
+  info.value = glyph.value;
+  info.offsetX = glyph.offsetX;
+  info.offsetY = glyph.offsetY;
+  info.advanceX = glyph.advanceX;
+  // Drawing only needs the atlas, so no per-glyph image is kept
+  info.image = raylib::Image{};
+}
+
+bool DynamicFont::flush(uint64_t frame) {
+  if (queued_.empty())
+    return false;
+
+  std::vector<int> codepoints;
+  codepoints.reserve(queued_.size());
+  for (const auto &[codepoint, pinned] : queued_) {
+    codepoints.push_back(codepoint);
+  }
+
+  const unsigned int old_texture = font_.texture.id;
+  const int old_count = font_.glyphCount;
+
+  raylib::GlyphInfo *glyphs = raylib::LoadFontData(
+      file_.data(), static_cast<int>(file_.size()),
+      config_.base_size, codepoints.data(),
+      static_cast<int>(codepoints.size()), raylib::FONT_DEFAULT);
+
+  for (size_t i = 0; glyphs && i < queued_.size(); i++) {
+    const auto [codepoint, pinned] = queued_[i];
+    const raylib::GlyphInfo &glyph = glyphs[i];
+    if (glyph.image.data == nullptr && glyph.advanceX == 0) {
+      missing_.insert(codepoint);
+      continue;
+    }
+
+    int slot = slots_.allocate(codepoint, frame, pinned);
+    if (slot < 0 && grow()) {
+      slot = slots_.allocate(codepoint, frame, pinned);
+    }
+    if (slot < 0) {
+      int evicted = -1;
+      slot = slots_.evict(codepoint, frame, evicted);
+    }
+    if (slot < 0) {
+      // Every cell is in use this frame; the glyph falls back to '?'
+      if (!warned_full_) {
+        log_warn("[glyph_atlas] Atlas full, raise Config::memory_budget");
+        warned_full_ = true;
+      }
+      continue;
+    }
+    upload(slot, glyph);
+  }
+  if (glyphs) {
+    raylib::UnloadFontData(glyphs, static_cast<int>(codepoints.size()));
+  }
+
+  queued_.clear();
+  queued_set_.clear();
+  font_.glyphCount = slots_.used();
+  return font_.texture.id != old_texture || font_.glyphCount != old_count;
+}
+
+DynamicFont *add(const std::string &name, const std::string &path,
+                 const Config &config) {
+  auto font = std::make_unique<DynamicFont>();
+  if (!font->open(path, config))
+    return nullptr;
+  DynamicFont *result = font.get();
+  registry().push_back(Entry{name, std::move(font)});
+  return result;
+}
+
+void begin_frame() { current_frame++; }
+
+void request_text(std::string_view text) {
+  auto &entries = registry();
+  if (entries.empty())
+    return;
+  for (size_t i = 0; i < text.size();) {
+    // ASCII is pinned in every atlas
+    if (static_cast<unsigned char>(text[i]) < 0x80) {
+      i++;
+      continue;
+    }
+    int codepoint = next_codepoint(text, i);
+    if (codepoint < 0)
+      continue;
+    for (Entry &entry : entries) {
+      entry.font->request(codepoint, current_frame);
+    }
+  }
+}
+
+void flush(const std::function<void(const std::string &name,
+                                    const raylib::Font &font)> &on_changed) {
+  for (Entry &entry : registry()) {
+    if (entry.font->flush(current_frame) && on_changed) {
+      on_changed(entry.name, entry.font->font());
+    }
+  }
+}
+
+size_t resident_bytes() {
+  size_t total = 0;
+  for (const Entry &entry : registry()) {
+    total += entry.font->texture_bytes();
+  }
+  return total;
+}
+
+std::vector<std::pair<std::string, size_t>> resident_by_font() {
+  std::vector<std::pair<std::string, size_t>> result;
+  for (const Entry &entry : registry()) {
+    result.emplace_back(entry.name, entry.font->texture_bytes());
+  }
+  return result;
+}
+
+void unload_all() { registry().clear(); }
+
+} // namespace glyph_atlas
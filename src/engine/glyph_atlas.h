@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../rl.h"
+#include "mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace glyph_atlas {
+
+// LRU bookkeeping for the fixed-size cells of an atlas. Slots are handed out
+// in order and evicted slots are reused in place, so a slot index is also the
+// glyph index in the font.
+class SlotTable {
+public:
+  // Capacity only ever grows
+  void reserve(int capacity);
+  int capacity() const { return static_cast<int>(slots_.size()); }
+  // Slots handed out so far
+  int used() const { return used_; }
+
+  int find(int codepoint) const;
+  void touch(int slot, uint64_t frame) { slots_[slot].last_used = frame; }
+
+  // Next never used slot, or -1 when the table is full
+  int allocate(int codepoint, uint64_t frame, bool pinned);
+  // Reuses the least recently used slot that is neither pinned nor used in
+  // this frame. Returns -1 if there is none; evicted gets the old codepoint.
+  int evict(int codepoint, uint64_t frame, int &evicted);
+
+private:
+  struct Slot {
+    int codepoint = -1;
+    uint64_t last_used = 0;
+    bool pinned = false;
+  };
+
+  std::vector<Slot> slots_;
+  std::unordered_map<int, int> index_;
+  int used_ = 0;
+};
+
+struct Config {
+  // Rasterization size, the font is scaled from this when drawn
+  int base_size = 64;
+  // Atlas pages are page_size x page_size, stacked vertically
+  int page_size = 1024;
+  // Texture memory the atlas may grow to before evicting glyphs
+  size_t memory_budget = 16 * 1024 * 1024;
+  // Codepoint ranges (inclusive) served beyond ASCII, empty means any
+  std::vector<std::pair<int, int>> ranges;
+};
+
+// A raylib font whose glyphs are rasterized the first time they are needed.
+// The glyph arrays never move, so copies of font() stay valid until the
+// texture grows or the glyph count changes; flush() reports when that
+// happens so the copy can be refreshed.
+class DynamicFont {
+public:
+  DynamicFont() = default;
+  ~DynamicFont();
+
+  DynamicFont(const DynamicFont &) = delete;
+  DynamicFont &operator=(const DynamicFont &) = delete;
+
+  // Maps the font file and rasterizes ASCII, which is never evicted
+  bool open(const std::string &path, const Config &config);
+  void unload();
+
+  const raylib::Font &font() const { return font_; }
+  size_t texture_bytes() const;
+  int glyph_count() const { return slots_.used(); }
+
+  // Marks the glyph as used this frame, queueing it if not rasterized yet
+  void request(int codepoint, uint64_t frame);
+  // Rasterizes and uploads queued glyphs. Returns true if font() changed.
+  bool flush(uint64_t frame);
+
+private:
+  bool wanted(int codepoint) const;
+  bool grow();
+  raylib::Rectangle cell_rect(int slot) const;
+  void upload(int slot, const raylib::GlyphInfo &glyph);
+
+  Config config_;
+  // The font file stays mapped for later rasterization
+  mapped_file::MappedFile file_;
+  raylib::Font font_{};
+  SlotTable slots_;
+  int cell_size_ = 0;
+  int cells_per_row_ = 0;
+  int pages_ = 0;
+  int max_pages_ = 0;
+  std::vector<std::pair<int, bool>> queued_;
+  std::unordered_set<int> queued_set_;
+  // Codepoints the font file has no glyph for
+  std::unordered_set<int> missing_;
+  bool warned_full_ = false;
+};
+
+// Process-wide registry of dynamic fonts, keyed by FontManager name
+DynamicFont *add(const std::string &name, const std::string &path,
+                 const Config &config);
+void begin_frame();
+// Requests every codepoint in the UTF-8 text from all dynamic fonts. Any
+// text drawn with a dynamic font must be requested each frame it is shown;
+// UpdateGlyphAtlas covers labels. Requests made before it runs are drawn
+// that frame, later ones (during rendering) from the next frame.
+void request_text(std::string_view text);
+// Flushes every font, calling on_changed for fonts whose struct changed
+void flush(const std::function<void(const std::string &name,
+                                    const raylib::Font &font)> &on_changed);
+size_t resident_bytes();
+// Texture bytes per dynamic font, by name
+std::vector<std::pair<std::string, size_t>> resident_by_font();
+// Must run while the GL context is still alive
+void unload_all();
+
+} // namespace glyph_atlas
@@ -0,0 +1,159 @@
+#include "gradient_texture.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <numbers>
+#include <unordered_map>
+
+namespace gradient_texture {
+
+namespace {
+
+// Texels along an axis-aligned gradient; 8 bit channels cannot step more
+// finely than this
+constexpr int LINE_TEXELS = 256;
+// Longer side of an angled bake
+constexpr int ANGLED_TEXELS = 64;
+
+const raylib::Texture2D EMPTY_TEXTURE{};
+
+std::unordered_map<uint64_t, raylib::Texture2D> &textures() {
+  static std::unordered_map<uint64_t, raylib::Texture2D> baked;
+  return baked;
+}
+
+uint8_t lerp_channel(uint8_t a, uint8_t b, float t) {
+  float value = static_cast<float>(a) +
+                (static_cast<float>(b) - static_cast<float>(a)) * t;
+  return static_cast<uint8_t>(std::clamp(std::lround(value), 0l, 255l));
+}
+
+// FNV-1a over everything that changes the baked pixels
+struct KeyHash {
+  uint64_t hash = 14695981039346656037ull;
+
+  template <typename T> void add(const T &value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (unsigned char byte : bytes) {
+      hash ^= byte;
+      hash *= 1099511628211ull;
+    }
+  }
+};
+
+raylib::Texture2D bake(std::span<const Stop> stops, float angle, int width,
+                       int height) {
+  raylib::Image image =
+      raylib::GenImageColor(width, height, raylib::Color{0, 0, 0, 0});
+  auto *pixels = static_cast<raylib::Color *>(image.data);
+
+  const float radians = angle * std::numbers::pi_v<float> / 180.f;
+  const float dx = std::cos(radians);
+  const float dy = std::sin(radians);
+  const float w = static_cast<float>(width);
+  const float h = static_cast<float>(height);
+  // Gradient line long enough that its ends touch the box's corners
+  const float length = std::abs(w * dx) + std::abs(h * dy);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      // Texel centers, so a stretched texture interpolates evenly
+      float px = static_cast<float>(x) + 0.5f - w / 2.f;
+      float py = static_cast<float>(y) + 0.5f - h / 2.f;
+      float t = (px * dx + py * dy) / length + 0.5f;
+      pixels[y * width + x] = sample(stops, t);
+    }
+  }
+
+  raylib::Texture2D texture = raylib::LoadTextureFromImage(image);
+  raylib::UnloadImage(image);
+  if (texture.id != 0) {
+    raylib::SetTextureFilter(texture, raylib::TEXTURE_FILTER_BILINEAR);
+    raylib::SetTextureWrap(texture, raylib::TEXTURE_WRAP_CLAMP);
+  }
+  return texture;
+}
+
+} // namespace
+
+raylib::Color sample(std::span<const Stop> stops, float t) {
+  if (stops.empty())
+    return raylib::Color{0, 0, 0, 0};
+  if (t <= stops.front().position)
+    return stops.front().color;
+  for (size_t i = 1; i < stops.size(); i++) {
+    const Stop &from = stops[i - 1];
+    const Stop &to = stops[i];
+    if (t > to.position)
+      continue;
+    float span = to.position - from.position;
+    float f = span > 0.f ? (t - from.position) / span : 1.f;
+    return raylib::Color{lerp_channel(from.color.r, to.color.r, f),
+                         lerp_channel(from.color.g, to.color.g, f),
+                         lerp_channel(from.color.b, to.color.b, f),
+                         lerp_channel(from.color.a, to.color.a, f)};
+  }
+  return stops.back().color;
+}
+
+const raylib::Texture2D &get(std::span<const Stop> stops, float angle_degrees,
+                             float width, float height) {
+  if (stops.empty())
+    return EMPTY_TEXTURE;
+
+  float angle = std::fmod(angle_degrees, 360.f);
+  if (angle < 0.f)
+    angle += 360.f;
+  // Whole degrees are plenty and keep float noise from splitting the cache
+  angle = std::round(angle);
+  if (angle == 360.f)
+    angle = 0.f;
+
+  int texels_x = LINE_TEXELS;
+  int texels_y = 1;
+  if (angle == 90.f || angle == 270.f) {
+    texels_x = 1;
+    texels_y = LINE_TEXELS;
+  } else if (angle != 0.f && angle != 180.f) {
+    float longer = std::max({width, height, 1.f});
+    float scale = static_cast<float>(ANGLED_TEXELS) / longer;
+    texels_x = std::max(2, static_cast<int>(std::lround(width * scale)));
+    texels_y = std::max(2, static_cast<int>(std::lround(height * scale)));
+  }
+
+  KeyHash key;
+  key.add(angle);
+  key.add(texels_x);
+  key.add(texels_y);
+  for (const Stop &stop : stops) {
+    key.add(stop.position);
+    key.add(stop.color.r);
+    key.add(stop.color.g);
+    key.add(stop.color.b);
+    key.add(stop.color.a);
+  }
+
+  auto &baked = textures();
+  auto it = baked.find(key.hash);
+  if (it == baked.end()) {
+    // Failed bakes are kept as well so they are not retried every frame
+    it = baked
+             .emplace(key.hash, bake(stops, angle, texels_x, texels_y))
+             .first;
+  }
+  return it->second;
+}
+
+size_t count() { return textures().size(); }
+
+void unload_all() {
+  for (auto &[key, texture] : textures()) {
+    if (texture.id != 0)
+      raylib::UnloadTexture(texture);
+  }
+  textures().clear();
+}
+
+} // namespace gradient_texture
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../rl.h"
+
+#include <cstddef>
+#include <span>
+
+// Linear gradients baked into small cached textures. Stretched over a box
+// with bilinear filtering a texture draws the whole gradient as one quad,
+// however smooth it is. Main thread only, it creates GL textures.
+namespace gradient_texture {
+
+struct Stop {
+  // 0 at the start of the gradient line, 1 at the end
+  float position;
+  raylib::Color color;
+};
+
+// Color at t along stops sorted by position; clamps outside the stops
+raylib::Color sample(std::span<const Stop> stops, float t);
+
+// Texture for stops at angle_degrees (0 runs left to right, 90 top to
+// bottom) across a width x height box. Axis-aligned gradients bake to one
+// row or column shared by every box size; other angles bake at the box's
+// aspect ratio. Baked once per distinct gradient and kept until
+// unload_all().
+const raylib::Texture2D &get(std::span<const Stop> stops, float angle_degrees,
+                             float width, float height);
+
+// Number of baked textures
+size_t count();
+
+// Before CloseWindow
+void unload_all();
+
+} // namespace gradient_texture
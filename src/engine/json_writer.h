@@ -0,0 +1,166 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace json_writer {
+
+// Minimal streaming JSON writer that appends compact JSON straight into a
+// caller-owned string. Nesting and separators are tracked internally, so the
+// caller only calls begin/end, key and value in document order.
+class JsonWriter {
+public:
+  explicit JsonWriter(std::string &out) : out_(out) { first_.reserve(32); }
+
+  void begin_object() { open('{'); }
+  void end_object() { close('}'); }
+  void begin_array() { open('['); }
+  void end_array() { close(']'); }
+
+  void key(std::string_view name) {
+    separator();
+    write_string(name);
+    out_.push_back(':');
+    after_key_ = true;
+  }
+
+  void value(std::string_view text) {
+    separator();
+    write_string(text);
+  }
+  void value(const char *text) { value(std::string_view(text)); }
+  void value(const std::string &text) { value(std::string_view(text)); }
+
+  void value(bool b) {
+    separator();
+    out_.append(b ? "true" : "false");
+  }
+
+  void value(int64_t number) {
+    separator();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, result.ptr);
+  }
+  void value(uint64_t number) {
+    separator();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, result.ptr);
+  }
+  void value(int number) { value(static_cast<int64_t>(number)); }
+
+  void value(double number) {
+    separator();
+    // JSON has no NaN or infinity
+    if (!std::isfinite(number)) {
+      out_.append("null");
+      return;
+    }
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, result.ptr);
+  }
+  void value(float number) {
+    separator();
+    if (!std::isfinite(number)) {
+      out_.append("null");
+      return;
+    }
+    // Shortest round-trip form of the float, not of its double widening
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out_.append(buffer, result.ptr);
+  }
+
+  void null() {
+    separator();
+    out_.append("null");
+  }
+
+  // Splices an already serialized JSON value in as the next element
+  void raw(std::string_view json) {
+    separator();
+    out_.append(json);
+  }
+
+  template <typename T> void field(std::string_view name, const T &v) {
+    key(name);
+    value(v);
+  }
+
+private:
+  void open(char c) {
+    separator();
+    out_.push_back(c);
+    first_.push_back(true);
+  }
+
+  void close(char c) {
+    first_.pop_back();
+    out_.push_back(c);
+  }
+
+  // Emits the comma between siblings; values right after a key need none
+  void separator() {
+    if (after_key_) {
+      after_key_ = false;
+      return;
+    }
+    if (first_.empty())
+      return;
+    if (first_.back()) {
+      first_.back() = false;
+    } else {
+      out_.push_back(',');
+    }
+  }
+
+  void write_string(std::string_view text) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    out_.push_back('"');
+    size_t run_start = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+      unsigned char c = static_cast<unsigned char>(text[i]);
+      if (c >= 0x20 && c != '"' && c != '\\')
+        continue;
+      out_.append(text.data() + run_start, i - run_start);
+      run_start = i + 1;
+      switch (c) {
+      case '"':
+        out_.append("\\\"");
+        break;
+      case '\\':
+        out_.append("\\\\");
+        break;
+      case '\n':
+        out_.append("\\n");
+        break;
+      case '\r':
+        out_.append("\\r");
+        break;
+      case '\t':
+        out_.append("\\t");
+        break;
+      default:
+        out_.append("\\u00");
+        out_.push_back(HEX[c >> 4]);
+        out_.push_back(HEX[c & 0xF]);
+        break;
+      }
+    }
+    out_.append(text.data() + run_start, text.size() - run_start);
+    out_.push_back('"');
+  }
+
+  std::string &out_;
+  // One entry per open container: true until its first element is written
+  std::vector<bool> first_;
+  bool after_key_ = false;
+};
+
+} // namespace json_writer
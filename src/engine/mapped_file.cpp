@@ -0,0 +1,101 @@
+#include "mapped_file.h"
+
+#include <fstream>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mapped_file {
+
+MappedFile::~MappedFile() { close(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this == &other)
+    return *this;
+  close();
+  buffer_ = std::move(other.buffer_);
+  data_ = (other.mapped_ || other.borrowed_ || !other.data_) ? other.data_
+                                                             : buffer_.data();
+  size_ = other.size_;
+  mapped_ = other.mapped_;
+  borrowed_ = other.borrowed_;
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.mapped_ = false;
+  other.borrowed_ = false;
+  return *this;
+}
+
+bool MappedFile::open(const std::string &path) {
+  close();
+
+#ifndef _WIN32
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+
+  size_t length = static_cast<size_t>(st.st_size);
+  void *ptr = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed
+  ::close(fd);
+  if (ptr == MAP_FAILED)
+    return false;
+
+  data_ = static_cast<const uint8_t *>(ptr);
+  size_ = length;
+  mapped_ = true;
+  return true;
+#else
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+    return false;
+  std::streamoff length = file.tellg();
+  if (length <= 0)
+    return false;
+  buffer_.resize(static_cast<size_t>(length));
+  file.seekg(0);
+  if (!file.read(reinterpret_cast<char *>(buffer_.data()), length)) {
+    buffer_.clear();
+    return false;
+  }
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+  return true;
+#endif
+}
+
+void MappedFile::view(const uint8_t *data, size_t size) {
+  close();
+  data_ = data;
+  size_ = size;
+  borrowed_ = true;
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+  if (mapped_ && data_) {
+    munmap(const_cast<uint8_t *>(data_), size_);
+  }
+#endif
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  data_ = nullptr;
+  size_ = 0;
+  mapped_ = false;
+  borrowed_ = false;
+}
+
+} // namespace mapped_file
@@ -0,0 +1,228 @@
+#include "post_fx.h"
+
+#include <array>
+#include <utility>
+
+namespace post_fx {
+
+namespace {
+
+constexpr std::array<std::pair<Pass, std::string_view>, 3> NAMES = {{
+    {Pass::Bloom, "bloom"},
+    {Pass::Crt, "crt"},
+    {Pass::Vignette, "vignette"},
+}};
+
+// Fragment shaders for raylib's default vertex shader. resolution is the
+// input texture's size in pixels.
+constexpr const char *HEADER = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+uniform vec2 resolution;
+out vec4 finalColor;
+)";
+
+// Adds a blurred copy of everything brighter than the threshold
+constexpr const char *BLOOM = R"(
+void main() {
+  vec4 base = texture(texture0, fragTexCoord);
+  vec2 spread = 2.0 / resolution;
+  vec3 glow = vec3(0.0);
+  for (int x = -2; x <= 2; x++) {
+    for (int y = -2; y <= 2; y++) {
+      vec3 tap = texture(texture0, fragTexCoord + vec2(x, y) * spread).rgb;
+      glow += max(tap - vec3(0.7), vec3(0.0));
+    }
+  }
+  finalColor = vec4(base.rgb + glow * (2.0 / 25.0), base.a) * colDiffuse *
+               fragColor;
+}
+)";
+
+// Slight barrel curve and scanlines one input row apart
+constexpr const char *CRT = R"(
+void main() {
+  vec2 centred = fragTexCoord * 2.0 - 1.0;
+  centred *= 1.0 + dot(centred, centred) * 0.03;
+  vec2 uv = centred * 0.5 + 0.5;
+  if (uv.x < 0.0 || uv.x > 1.0 || uv.y < 0.0 || uv.y > 1.0) {
+    finalColor = vec4(0.0, 0.0, 0.0, 1.0);
+    return;
+  }
+  vec4 color = texture(texture0, uv);
+  float scan = 0.85 + 0.15 * sin(uv.y * resolution.y * 3.14159);
+  finalColor = vec4(color.rgb * scan, color.a) * colDiffuse * fragColor;
+}
+)";
+
+// Darkens towards the corners
+constexpr const char *VIGNETTE = R"(
+void main() {
+  vec4 color = texture(texture0, fragTexCoord);
+  float edge = 1.0 - smoothstep(0.35, 0.8, distance(fragTexCoord, vec2(0.5)));
+  finalColor = vec4(color.rgb * mix(0.4, 1.0, edge), color.a) * colDiffuse *
+               fragColor;
+}
+)";
+
+struct LoadedShader {
+  raylib::Shader shader{};
+  int resolution_loc = -1;
+  bool loaded = false;
+};
+
+struct State {
+  std::vector<Pass> chain;
+  // Second ping-pong target; screenRT is the first
+  raylib::RenderTexture2D scratch{};
+  std::array<LoadedShader, NAMES.size()> shaders{};
+};
+
+State &state() {
+  static State instance;
+  return instance;
+}
+
+const char *body(Pass pass) {
+  switch (pass) {
+  case Pass::Bloom:
+    return BLOOM;
+  case Pass::Crt:
+    return CRT;
+  case Pass::Vignette:
+    return VIGNETTE;
+  }
+  return VIGNETTE;
+}
+
+LoadedShader &shader(Pass pass) {
+  LoadedShader &entry = state().shaders[static_cast<size_t>(pass)];
+  if (!entry.loaded) {
+    const std::string code = std::string(HEADER) + body(pass);
+    // raylib falls back to its default shader when compiling fails, which
+    // turns the pass into a plain copy
+    entry.shader = raylib::LoadShaderFromMemory(nullptr, code.c_str());
+    entry.resolution_loc =
+        raylib::GetShaderLocation(entry.shader, "resolution");
+    entry.loaded = true;
+  }
+  return entry;
+}
+
+// Allocates target at width x height when wanted, frees it otherwise
+void fit(raylib::RenderTexture2D &target, bool wanted, int width,
+         int height) {
+  const bool fits = target.id != 0 && target.texture.width == width &&
+                    target.texture.height == height;
+  if (wanted ? fits : target.id == 0)
+    return;
+  if (target.id != 0) {
+    raylib::UnloadRenderTexture(target);
+    target = {};
+  }
+  if (wanted)
+    target = raylib::LoadRenderTexture(width, height);
+}
+
+void draw_pass(Pass pass, const raylib::Texture2D &input,
+               raylib::Rectangle dst) {
+  LoadedShader &entry = shader(pass);
+  const float resolution[2] = {static_cast<float>(input.width),
+                               static_cast<float>(input.height)};
+  raylib::SetShaderValue(entry.shader, entry.resolution_loc, resolution,
+                         raylib::SHADER_UNIFORM_VEC2);
+  raylib::BeginShaderMode(entry.shader);
+  raylib::DrawTexturePro(input,
+                         raylib::Rectangle{0.f, 0.f, resolution[0],
+                                           -resolution[1]},
+                         dst, raylib::Vector2{0.f, 0.f}, 0.f, raylib::WHITE);
+  raylib::EndShaderMode();
+}
+
+} // namespace
+
+bool parse(std::string_view list, std::vector<Pass> &out) {
+  std::vector<Pass> passes;
+  while (!list.empty()) {
+    const size_t comma = list.find(',');
+    const std::string_view name = list.substr(0, comma);
+    list = comma == std::string_view::npos ? std::string_view{}
+                                           : list.substr(comma + 1);
+    if (name.empty() || name == "none")
+      continue;
+    bool known = false;
+    for (const auto &[pass, pass_name] : NAMES) {
+      if (name == pass_name) {
+        passes.push_back(pass);
+        known = true;
+        break;
+      }
+    }
+    if (!known)
+      return false;
+  }
+  out = std::move(passes);
+  return true;
+}
+
+std::string to_string(const std::vector<Pass> &passes) {
+  std::string list;
+  for (Pass pass : passes) {
+    if (!list.empty())
+      list += ',';
+    list += NAMES[static_cast<size_t>(pass)].second;
+  }
+  return list;
+}
+
+void set_chain(std::vector<Pass> passes) { state().chain = std::move(passes); }
+
+const std::vector<Pass> &chain() { return state().chain; }
+
+void present(const raylib::Texture2D &source, raylib::Rectangle dst,
+             bool enabled) {
+  State &s = state();
+  const size_t passes = enabled ? s.chain.size() : 0;
+  const int width = source.width;
+  const int height = source.height;
+
+  // The last pass draws to the window, so one pass needs no target
+  fit(screenRT, passes >= 2, width, height);
+  fit(s.scratch, passes >= 3, width, height);
+
+  if (passes == 0) {
+    raylib::DrawTexturePro(
+        source,
+        raylib::Rectangle{0.f, 0.f, static_cast<float>(width),
+                          -static_cast<float>(height)},
+        dst, raylib::Vector2{0.f, 0.f}, 0.f, raylib::WHITE);
+    return;
+  }
+
+  const raylib::Rectangle full{0.f, 0.f, static_cast<float>(width),
+                               static_cast<float>(height)};
+  const raylib::Texture2D *input = &source;
+  for (size_t i = 0; i + 1 < passes; i++) {
+    raylib::RenderTexture2D &target = i % 2 == 0 ? screenRT : s.scratch;
+    raylib::BeginTextureMode(target);
+    draw_pass(s.chain[i], *input, full);
+    raylib::EndTextureMode();
+    input = &target.texture;
+  }
+  draw_pass(s.chain.back(), *input, dst);
+}
+
+void unload_all() {
+  State &s = state();
+  fit(screenRT, false, 0, 0);
+  fit(s.scratch, false, 0, 0);
+  for (LoadedShader &entry : s.shaders) {
+    if (entry.loaded)
+      raylib::UnloadShader(entry.shader);
+    entry = {};
+  }
+}
+
+} // namespace post_fx
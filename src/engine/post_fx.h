@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../rl.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Shader passes applied while mainRT is presented to the window. The last
+// pass draws straight to the window; earlier ones ping-pong through
+// screenRT (and a second scratch target from three passes up). Targets and
+// shaders exist only while a chain is active, so with no passes the present
+// is the same single blit as before. mainRT itself is never modified, so
+// screenshots and snapshot tests see the unprocessed frame. Main thread
+// only.
+namespace post_fx {
+
+enum class Pass { Bloom, Crt, Vignette };
+
+// Comma-separated pass names ("bloom,crt,vignette"); empty or "none" is no
+// passes. False (and out untouched) on an unknown name.
+bool parse(std::string_view list, std::vector<Pass> &out);
+
+std::string to_string(const std::vector<Pass> &passes);
+
+void set_chain(std::vector<Pass> passes);
+const std::vector<Pass> &chain();
+
+// Draws source (a render texture, so stored bottom-up) into dst on the
+// current framebuffer, through the chain when enabled and non-empty. Call
+// between BeginDrawing and EndDrawing.
+void present(const raylib::Texture2D &source, raylib::Rectangle dst,
+             bool enabled);
+
+// Frees screenRT, the scratch target and the shaders. Before CloseWindow.
+void unload_all();
+
+} // namespace post_fx
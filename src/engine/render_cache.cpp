@@ -0,0 +1,23 @@
+#include "render_cache.h"
+
+namespace render_cache {
+
+bool Layer::resize(int width, int height) {
+  if (target_.id != 0 && target_.texture.width == width &&
+      target_.texture.height == height)
+    return true;
+  unload();
+  if (width <= 0 || height <= 0)
+    return false;
+  target_ = raylib::LoadRenderTexture(width, height);
+  return target_.id != 0;
+}
+
+void Layer::unload() {
+  if (target_.id != 0)
+    raylib::UnloadRenderTexture(target_);
+  target_ = {};
+  valid_ = false;
+}
+
+} // namespace render_cache
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../rl.h"
+
+#include <cstdint>
+#include <cstring>
+
+// Static decoration drawn once with raylib into an offscreen texture and
+// shown from there until its inputs change (NeonStrike's compass ticks and
+// minimap grid). Not a cache for UI subtrees: nothing is invalidated by
+// theme or font changes unless the caller puts them in the key. Main thread
+// only, outside any other BeginTextureMode/BeginDrawing pair (screens call
+// it from their update).
+namespace render_cache {
+
+// FNV-1a over the values a layer is drawn from: colors, sizes, positions
+class Key {
+public:
+  template <typename T> Key &add(const T &value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (unsigned char byte : bytes) {
+      hash_ ^= byte;
+      hash_ *= 1099511628211ull;
+    }
+    return *this;
+  }
+  uint64_t value() const { return hash_; }
+
+private:
+  uint64_t hash_ = 14695981039346656037ull;
+};
+
+class Layer {
+public:
+  Layer() = default;
+  ~Layer() { unload(); }
+
+  Layer(const Layer &) = delete;
+  Layer &operator=(const Layer &) = delete;
+
+  // The layer's texture, redrawn first when key or size changed since the
+  // last call. draw() runs with the texture bound and cleared to
+  // transparent, in texture pixel coordinates. RenderTextures are stored
+  // upside down; draw the result with a negative source height.
+  template <typename Draw>
+  const raylib::Texture2D &get(uint64_t key, int width, int height,
+                               Draw &&draw) {
+    if (!valid_ || key != key_ || width != target_.texture.width ||
+        height != target_.texture.height) {
+      if (!resize(width, height))
+        return target_.texture;
+      raylib::BeginTextureMode(target_);
+      raylib::ClearBackground(raylib::Color{0, 0, 0, 0});
+      draw();
+      raylib::EndTextureMode();
+      key_ = key;
+      valid_ = true;
+      redraws_++;
+    }
+    return target_.texture;
+  }
+
+  // Times the layer has been drawn, for tests and the perf hud
+  int redraws() const { return redraws_; }
+
+  void unload();
+
+private:
+  bool resize(int width, int height);
+
+  raylib::RenderTexture2D target_{};
+  uint64_t key_ = 0;
+  bool valid_ = false;
+  int redraws_ = 0;
+};
+
+} // namespace render_cache
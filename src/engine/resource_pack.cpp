@@ -0,0 +1,167 @@
+#include "resource_pack.h"
+
+#include "../log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+namespace resource_pack {
+
+namespace {
+
+constexpr char MAGIC[4] = {'A', 'H', 'R', 'P'};
+constexpr uint32_t VERSION = 1;
+
+struct Header {
+  char magic[4];
+  uint32_t version;
+  uint32_t count;
+  uint32_t reserved;
+};
+
+struct Mounted {
+  Pack pack;
+  bool ok = false;
+  int64_t mtime = 0;
+  // Absolute, normalized, with a trailing '/'
+  std::string root;
+  // Resolves relative lookups without a getcwd per call
+  std::filesystem::path cwd;
+};
+
+// Written once by mount() before any worker starts, read-only afterwards
+Mounted &mounted_pack() {
+  static Mounted state;
+  return state;
+}
+
+// Path relative to the mounted root, or false if it lies outside it
+bool key_for(const Mounted &state, const std::string &path, std::string &out) {
+  std::filesystem::path full(path);
+  if (full.is_relative())
+    full = state.cwd / full;
+  std::string normal = full.lexically_normal().generic_string();
+  if (!normal.starts_with(state.root))
+    return false;
+  out = normal.substr(state.root.size());
+  return true;
+}
+
+} // namespace
+
+uint64_t hash_key(std::string_view key) {
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : key) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+bool Pack::open(const std::string &path) {
+  mapped_file::MappedFile file;
+  if (!file.open(path) || !attach(file.data(), file.size()))
+    return false;
+  file_ = std::move(file);
+  return true;
+}
+
+bool Pack::attach(const uint8_t *data, size_t size) {
+  data_ = nullptr;
+  bytes_ = 0;
+  entries_ = nullptr;
+  count_ = 0;
+
+  Header header;
+  if (size < sizeof(header))
+    return false;
+  std::memcpy(&header, data, sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header.version != VERSION ||
+      header.count > (size - sizeof(header)) / sizeof(Entry))
+    return false;
+
+  // Every entry is checked up front so find() never reads out of bounds
+  const auto *entries = reinterpret_cast<const Entry *>(data + sizeof(header));
+  for (size_t i = 0; i < header.count; i++) {
+    const Entry &entry = entries[i];
+    if (entry.offset > size || entry.size > size - entry.offset ||
+        entry.key_offset > size || entry.key_size > size - entry.key_offset)
+      return false;
+    if (i > 0 && entries[i - 1].key_hash > entry.key_hash)
+      return false;
+  }
+
+  data_ = data;
+  bytes_ = size;
+  entries_ = entries;
+  count_ = header.count;
+  return true;
+}
+
+std::span<const uint8_t> Pack::find(std::string_view key) const {
+  const uint64_t hash = hash_key(key);
+  const Entry *end = entries_ + count_;
+  const Entry *it =
+      std::lower_bound(entries_, end, hash, [](const Entry &entry, uint64_t h) {
+        return entry.key_hash < h;
+      });
+  for (; it != end && it->key_hash == hash; ++it) {
+    std::string_view stored(reinterpret_cast<const char *>(data_) +
+                                it->key_offset,
+                            it->key_size);
+    if (stored == key)
+      return {data_ + it->offset, static_cast<size_t>(it->size)};
+  }
+  return {};
+}
+
+bool mount(const std::string &resources_root) {
+  Mounted &state = mounted_pack();
+  std::error_code ec;
+  state.cwd = std::filesystem::current_path(ec);
+  std::filesystem::path root =
+      (state.cwd / resources_root).lexically_normal();
+  std::string root_name = root.generic_string();
+  while (!root_name.empty() && root_name.back() == '/')
+    root_name.pop_back();
+
+  const std::string pack_path = root_name + ".pack";
+  if (!std::filesystem::exists(pack_path, ec))
+    return false;
+  if (!state.pack.open(pack_path)) {
+    log_warn("[resource_pack] Ignoring invalid {}", pack_path);
+    return false;
+  }
+  auto mtime = std::filesystem::last_write_time(pack_path, ec);
+  state.mtime = ec ? 0 : static_cast<int64_t>(mtime.time_since_epoch().count());
+  state.root = root_name + "/";
+  state.ok = true;
+  log_info("[resource_pack] Mounted {} ({} files)", pack_path,
+           state.pack.size());
+  return true;
+}
+
+bool mounted() { return mounted_pack().ok; }
+
+std::span<const uint8_t> find(const std::string &path) {
+  const Mounted &state = mounted_pack();
+  std::string key;
+  if (!state.ok || !key_for(state, path, key))
+    return {};
+  return state.pack.find(key);
+}
+
+bool open(mapped_file::MappedFile &file, const std::string &path) {
+  std::span<const uint8_t> bytes = find(path);
+  if (bytes.empty())
+    return file.open(path);
+  file.view(bytes.data(), bytes.size());
+  return true;
+}
+
+int64_t mtime() { return mounted_pack().mtime; }
+
+} // namespace resource_pack
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace resource_pack {
+
+// FNV-1a 64, the key hash scripts/pack_resources.py sorts the index by
+uint64_t hash_key(std::string_view key);
+
+// resources/ bundled into one file by scripts/pack_resources.py (run
+// `make pack`). Lookups binary search the hashed index and return views
+// into the mapping, nothing is copied.
+class Pack {
+public:
+  bool open(const std::string &path);
+  // Validates a pack already in memory; the bytes must outlive the Pack
+  bool attach(const uint8_t *data, size_t size);
+
+  // The file stored under key (its path relative to resources/), empty if
+  // it was not packed
+  std::span<const uint8_t> find(std::string_view key) const;
+  size_t size() const { return count_; }
+
+private:
+  struct Entry {
+    uint64_t key_hash;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t key_offset;
+    uint32_t key_size;
+  };
+  static_assert(sizeof(Entry) == 32, "must match the packer's entry layout");
+
+  mapped_file::MappedFile file_;
+  const uint8_t *data_ = nullptr;
+  size_t bytes_ = 0;
+  const Entry *entries_ = nullptr;
+  size_t count_ = 0;
+};
+
+// Mounts <resources root>.pack, e.g. resources.pack next to resources/.
+// Without it (the usual development setup) every lookup misses and callers
+// read the loose files.
+bool mount(const std::string &resources_root);
+bool mounted();
+
+// The packed bytes for a path under the resources root (as returned by
+// files::get_resource_path), empty if there is no pack or no such entry
+std::span<const uint8_t> find(const std::string &path);
+
+// Maps path from the pack when it is there, otherwise from disk
+bool open(mapped_file::MappedFile &file, const std::string &path);
+
+// Modification time of the mounted pack, stamped on cache entries derived
+// from packed files
+int64_t mtime();
+
+} // namespace resource_pack
@@ -0,0 +1,441 @@
+#include "screenshot_encoder.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <iterator>
+#include <cstdio>
+#include <cstring>
+
+namespace screenshot_encoder {
+
+namespace {
+
+struct Frame {
+  std::vector<uint8_t> pixels;
+  int width = 0;
+  int height = 0;
+};
+
+// Crops, flips to top-down and box-downscales the GL readback in one pass
+Frame extract(const raylib::Image &image, const Options &options) {
+  const auto *src = static_cast<const uint8_t *>(image.data);
+  int x0 = 0, y0 = 0, x1 = image.width, y1 = image.height;
+  if (options.region.width > 0 && options.region.height > 0) {
+    x0 = std::clamp(static_cast<int>(options.region.x), 0, image.width);
+    y0 = std::clamp(static_cast<int>(options.region.y), 0, image.height);
+    x1 = std::clamp(static_cast<int>(options.region.x + options.region.width),
+                    x0, image.width);
+    y1 = std::clamp(static_cast<int>(options.region.y + options.region.height),
+                    y0, image.height);
+  }
+
+  const int scale = std::max(1, options.scale);
+  Frame frame;
+  frame.width = (x1 - x0) / scale;
+  frame.height = (y1 - y0) / scale;
+  if (frame.width <= 0 || frame.height <= 0)
+    return frame;
+  frame.pixels.resize(static_cast<size_t>(frame.width) *
+                      static_cast<size_t>(frame.height) * 4);
+
+  const size_t src_stride = static_cast<size_t>(image.width) * 4;
+  // Screen row y lives at image row (height - 1 - y) in the readback
+  auto src_row = [&](int y) {
+    return src + static_cast<size_t>(image.height - 1 - y) * src_stride +
+           static_cast<size_t>(x0) * 4;
+  };
+
+  uint8_t *dst = frame.pixels.data();
+  const size_t dst_stride = static_cast<size_t>(frame.width) * 4;
+  if (scale == 1) {
+    for (int y = 0; y < frame.height; y++) {
+      std::memcpy(dst + static_cast<size_t>(y) * dst_stride, src_row(y0 + y),
+                  dst_stride);
+    }
+    return frame;
+  }
+
+  const int area = scale * scale;
+  std::vector<uint32_t> sums(static_cast<size_t>(frame.width) * 4);
+  for (int y = 0; y < frame.height; y++) {
+    std::fill(sums.begin(), sums.end(), 0u);
+    for (int sy = 0; sy < scale; sy++) {
+      const uint8_t *row = src_row(y0 + y * scale + sy);
+      for (int x = 0; x < frame.width; x++) {
+        uint32_t *sum = &sums[static_cast<size_t>(x) * 4];
+        const uint8_t *px = row + static_cast<size_t>(x * scale) * 4;
+        for (int sx = 0; sx < scale; sx++, px += 4) {
+          sum[0] += px[0];
+          sum[1] += px[1];
+          sum[2] += px[2];
+          sum[3] += px[3];
+        }
+      }
+    }
+    uint8_t *out = dst + static_cast<size_t>(y) * dst_stride;
+    for (size_t i = 0; i < sums.size(); i++) {
+      out[i] = static_cast<uint8_t>((sums[i] + area / 2) / area);
+    }
+  }
+  return frame;
+}
+
+// 64-bit multiply-mix over whole words, fast enough to run every capture
+uint64_t hash_frame(const Frame &frame) {
+  constexpr uint64_t PRIME = 0x9E3779B97F4A7C15ull;
+  uint64_t hash = (static_cast<uint64_t>(frame.width) << 32) ^
+                  static_cast<uint64_t>(frame.height);
+  const uint8_t *bytes = frame.pixels.data();
+  const size_t size = frame.pixels.size();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * PRIME;
+    hash ^= hash >> 29;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ bytes[i]) * PRIME;
+  }
+  return hash;
+}
+
+std::vector<uint8_t> encode_png(Frame &frame) {
+  raylib::Image image{};
+  image.data = frame.pixels.data();
+  image.width = frame.width;
+  image.height = frame.height;
+  image.mipmaps = 1;
+  image.format = raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+  int file_size = 0;
+  unsigned char *png_data =
+      raylib::ExportImageToMemory(image, ".png", &file_size);
+  if (png_data == nullptr || file_size <= 0) {
+    return {};
+  }
+  std::vector<uint8_t> result(png_data, png_data + file_size);
+  raylib::MemFree(png_data);
+  return result;
+}
+
+// CRC-32 (PNG chunks) with the usual byte table
+uint32_t crc32(uint32_t crc, const uint8_t *data, size_t size) {
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t n = 0; n < 256; n++) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      t[n] = c;
+    }
+    return t;
+  }();
+  crc = ~crc;
+  for (size_t i = 0; i < size; i++) {
+    crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void put_u32_be(std::vector<uint8_t> &out, uint32_t value) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+void put_chunk(std::vector<uint8_t> &out, const char type[4],
+               const uint8_t *data, size_t size) {
+  put_u32_be(out, static_cast<uint32_t>(size));
+  const size_t start = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data, data + size);
+  put_u32_be(out, crc32(0, out.data() + start, size + 4));
+}
+
+// Filters each scanline with Sub or Up, whichever leaves the smaller sum
+// of absolute byte values (libpng's heuristic over two filters). Flat UI
+// regions become runs of zeros that the LZ77 pass below squeezes well.
+std::vector<uint8_t> filter_rows(const Frame &frame) {
+  const size_t row_bytes = static_cast<size_t>(frame.width) * 4;
+  std::vector<uint8_t> raw((row_bytes + 1) * static_cast<size_t>(frame.height));
+  auto magnitude = [](uint8_t value) {
+    return value < 128 ? value : 256u - value;
+  };
+  for (int y = 0; y < frame.height; y++) {
+    const uint8_t *row =
+        frame.pixels.data() + static_cast<size_t>(y) * row_bytes;
+    const uint8_t *prev = y > 0 ? row - row_bytes : nullptr;
+    uint8_t *out = raw.data() + static_cast<size_t>(y) * (row_bytes + 1);
+
+    uint32_t sub_cost = 0, up_cost = 0;
+    for (size_t i = 0; i < row_bytes; i++) {
+      sub_cost += magnitude(
+          static_cast<uint8_t>(row[i] - (i >= 4 ? row[i - 4] : 0)));
+      if (prev)
+        up_cost += magnitude(static_cast<uint8_t>(row[i] - prev[i]));
+    }
+    if (prev && up_cost < sub_cost) {
+      out[0] = 2;
+      for (size_t i = 0; i < row_bytes; i++)
+        out[1 + i] = static_cast<uint8_t>(row[i] - prev[i]);
+    } else {
+      out[0] = 1;
+      for (size_t i = 0; i < row_bytes; i++)
+        out[1 + i] = static_cast<uint8_t>(row[i] - (i >= 4 ? row[i - 4] : 0));
+    }
+  }
+  return raw;
+}
+
+uint32_t adler32(const uint8_t *data, size_t size) {
+  uint32_t a = 1, b = 0;
+  while (size > 0) {
+    // 5552 bytes is the longest run adler32 can sum before reducing
+    const size_t run = std::min<size_t>(size, 5552);
+    for (size_t i = 0; i < run; i++) {
+      a += data[i];
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+    data += run;
+    size -= run;
+  }
+  return (b << 16) | a;
+}
+
+// LSB-first bit packer for deflate
+class BitWriter {
+public:
+  explicit BitWriter(std::vector<uint8_t> &out) : out_(out) {}
+
+  void put(uint32_t value, int count) {
+    bits_ |= static_cast<uint64_t>(value) << used_;
+    used_ += count;
+    while (used_ >= 8) {
+      out_.push_back(static_cast<uint8_t>(bits_));
+      bits_ >>= 8;
+      used_ -= 8;
+    }
+  }
+
+  void finish() {
+    if (used_ > 0)
+      out_.push_back(static_cast<uint8_t>(bits_));
+    bits_ = 0;
+    used_ = 0;
+  }
+
+private:
+  std::vector<uint8_t> &out_;
+  uint64_t bits_ = 0;
+  int used_ = 0;
+};
+
+// Fixed Huffman literal/length code (RFC 1951 3.2.6), bit reversed so it
+// can go through the LSB-first writer
+struct Code {
+  uint16_t bits;
+  uint8_t length;
+};
+
+const std::array<Code, 288> &fixed_codes() {
+  static const std::array<Code, 288> table = [] {
+    std::array<Code, 288> t{};
+    for (uint32_t symbol = 0; symbol < 288; symbol++) {
+      uint32_t code = 0;
+      int length = 0;
+      if (symbol < 144) {
+        code = 0x30 + symbol;
+        length = 8;
+      } else if (symbol < 256) {
+        code = 0x190 + symbol - 144;
+        length = 9;
+      } else if (symbol < 280) {
+        code = symbol - 256;
+        length = 7;
+      } else {
+        code = 0xC0 + symbol - 280;
+        length = 8;
+      }
+      uint32_t reversed = 0;
+      for (int i = 0; i < length; i++)
+        reversed |= ((code >> i) & 1u) << (length - 1 - i);
+      t[symbol] = Code{static_cast<uint16_t>(reversed),
+                       static_cast<uint8_t>(length)};
+    }
+    return t;
+  }();
+  return table;
+}
+
+int floor_log2(uint32_t value) { return std::bit_width(value) - 1; }
+
+void put_symbol(BitWriter &bits, uint32_t symbol) {
+  const Code code = fixed_codes()[symbol];
+  bits.put(code.bits, code.length);
+}
+
+// length is 3..258, distance 1..32768
+void put_match(BitWriter &bits, uint32_t length, uint32_t distance) {
+  if (length == 258) {
+    put_symbol(bits, 285);
+  } else {
+    const uint32_t v = length - 3;
+    if (v < 8) {
+      put_symbol(bits, 257 + v);
+    } else {
+      const int extra = floor_log2(v) - 2;
+      put_symbol(bits, 257 + 4 * static_cast<uint32_t>(extra + 1) +
+                           ((v >> extra) & 3u));
+      bits.put(v & ((1u << extra) - 1), extra);
+    }
+  }
+
+  // Distance codes are a plain 5 bits, and 5 reversed is still 5 bits
+  const uint32_t d = distance - 1;
+  uint32_t code = d;
+  int extra = 0;
+  if (d >= 4) {
+    extra = floor_log2(d) - 1;
+    code = 2 * static_cast<uint32_t>(extra + 1) + ((d >> extra) & 1u);
+  }
+  uint32_t reversed = 0;
+  for (int i = 0; i < 5; i++)
+    reversed |= ((code >> i) & 1u) << (4 - i);
+  bits.put(reversed, 5);
+  if (extra > 0)
+    bits.put(d & ((1u << extra) - 1), extra);
+}
+
+// One fixed-Huffman deflate block with greedy LZ77 over a single-entry
+// hash table, about zlib level 1 speed. Positions inside a match are not
+// hashed, which costs some ratio on busy images but none on flat ones.
+void deflate_fast(const uint8_t *data, size_t size,
+                  std::vector<uint8_t> &out) {
+  constexpr int HASH_BITS = 15;
+  constexpr size_t WINDOW = 32768;
+  constexpr size_t MAX_MATCH = 258;
+  // Stores position + 1, zero means empty
+  std::vector<uint32_t> head(size_t{1} << HASH_BITS, 0);
+  auto read32 = [&](size_t at) {
+    uint32_t word;
+    std::memcpy(&word, data + at, sizeof(word));
+    return word;
+  };
+
+  BitWriter bits(out);
+  // BFINAL, BTYPE 01 (fixed Huffman)
+  bits.put(1, 1);
+  bits.put(1, 2);
+  size_t i = 0;
+  while (i + 4 <= size) {
+    const uint32_t word = read32(i);
+    const uint32_t slot = (word * 2654435761u) >> (32 - HASH_BITS);
+    const size_t candidate = head[slot];
+    head[slot] = static_cast<uint32_t>(i + 1);
+    if (candidate > 0 && i - (candidate - 1) <= WINDOW &&
+        read32(candidate - 1) == word) {
+      const size_t from = candidate - 1;
+      const size_t limit = std::min(MAX_MATCH, size - i);
+      size_t length = 4;
+      while (length < limit && data[from + length] == data[i + length])
+        length++;
+      put_match(bits, static_cast<uint32_t>(length),
+                static_cast<uint32_t>(i - from));
+      i += length;
+    } else {
+      put_symbol(bits, data[i]);
+      i++;
+    }
+  }
+  for (; i < size; i++)
+    put_symbol(bits, data[i]);
+  put_symbol(bits, 256);
+  bits.finish();
+}
+
+// A standard PNG with cheap compression: Sub/Up filtering and a single
+// pass of fast deflate, instead of raylib's five filters and slow deflate.
+// Several times faster than Png and still far smaller than raw pixels.
+std::vector<uint8_t> encode_png_fast(const Frame &frame) {
+  const std::vector<uint8_t> raw = filter_rows(frame);
+
+  std::vector<uint8_t> idat;
+  idat.reserve(raw.size() / 4 + 64);
+  // zlib header: deflate, 32K window, fastest level hint
+  idat.push_back(0x78);
+  idat.push_back(0x01);
+  deflate_fast(raw.data(), raw.size(), idat);
+  put_u32_be(idat, adler32(raw.data(), raw.size()));
+
+  std::vector<uint8_t> png;
+  png.reserve(idat.size() + 64);
+  const uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  png.insert(png.end(), std::begin(signature), std::end(signature));
+  std::vector<uint8_t> header;
+  put_u32_be(header, static_cast<uint32_t>(frame.width));
+  put_u32_be(header, static_cast<uint32_t>(frame.height));
+  // 8 bit RGBA, deflate, adaptive filtering, no interlace
+  header.insert(header.end(), {8, 6, 0, 0, 0});
+  put_chunk(png, "IHDR", header.data(), header.size());
+  put_chunk(png, "IDAT", idat.data(), idat.size());
+  put_chunk(png, "IEND", nullptr, 0);
+  return png;
+}
+
+} // namespace
+
+bool parse_format(const std::string &name, Format &out) {
+  if (name == "png") {
+    out = Format::Png;
+  } else if (name == "fast") {
+    out = Format::Fast;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool parse_region(const std::string &text, raylib::Rectangle &out) {
+  float x = 0, y = 0, width = 0, height = 0;
+  if (std::sscanf(text.c_str(), "%f,%f,%f,%f", &x, &y, &width, &height) != 4 ||
+      width <= 0 || height <= 0) {
+    return false;
+  }
+  out = raylib::Rectangle{x, y, width, height};
+  return true;
+}
+
+std::vector<uint8_t> Encoder::capture(const raylib::RenderTexture2D &rt,
+                                      const Options &options) {
+  raylib::Image image = raylib::LoadImageFromTexture(rt.texture);
+  if (image.data == nullptr) {
+    return {};
+  }
+  raylib::ImageFormat(&image, raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  Frame frame = extract(image, options);
+  raylib::UnloadImage(image);
+  if (frame.pixels.empty()) {
+    return {};
+  }
+
+  uint64_t hash = hash_frame(frame);
+  if (options.skip_unchanged && !last_png_.empty() && hash == last_hash_) {
+    return last_png_;
+  }
+  std::vector<uint8_t> result = options.format == Format::Fast
+                                    ? encode_png_fast(frame)
+                                    : encode_png(frame);
+  // Only a frame the client actually received counts as the last capture
+  if (options.skip_unchanged && !result.empty()) {
+    last_hash_ = hash;
+    last_png_ = result;
+  }
+  return result;
+}
+
+} // namespace screenshot_encoder
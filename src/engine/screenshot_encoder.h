@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../rl.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace screenshot_encoder {
+
+// Every payload is a PNG, since the MCP server always labels screenshots
+// image/png. Fast trades size for speed: Sub/Up filtering and a single
+// fixed-Huffman deflate pass instead of raylib's full encoder.
+enum class Format { Png, Fast };
+
+struct Options {
+  Format format = Format::Png;
+  // Crop in screen pixels (top-left origin); empty means the whole frame
+  raylib::Rectangle region{0, 0, 0, 0};
+  // Integer box downscale factor applied after the crop
+  int scale = 1;
+  bool skip_unchanged = false;
+};
+
+bool parse_format(const std::string &name, Format &out);
+// Parses "x,y,width,height"
+bool parse_region(const std::string &text, raylib::Rectangle &out);
+
+class Encoder {
+public:
+  // Reads back the render texture and encodes it per options. With
+  // skip_unchanged, a frame matching the previous capture returns the
+  // previous PNG again without encoding. That saves the encode only: the
+  // caller still sends the full payload.
+  std::vector<uint8_t> capture(const raylib::RenderTexture2D &rt,
+                               const Options &options);
+
+private:
+  uint64_t last_hash_ = 0;
+  std::vector<uint8_t> last_png_;
+};
+
+} // namespace screenshot_encoder
@@ -0,0 +1,156 @@
+#include "sprite_atlas.h"
+
+#include "../log.h"
+#include "mapped_file.h"
+#include "resource_pack.h"
+
+#include <afterhours/src/plugins/files.h>
+#include <algorithm>
+#include <charconv>
+
+namespace sprite_atlas {
+
+namespace {
+
+// Splits off the next space separated field
+std::string_view next_field(std::string_view &line) {
+  size_t start = line.find_first_not_of(' ');
+  if (start == std::string_view::npos) {
+    line = {};
+    return {};
+  }
+  line.remove_prefix(start);
+  size_t end = line.find(' ');
+  std::string_view field = line.substr(0, end);
+  line.remove_prefix(end == std::string_view::npos ? line.size() : end);
+  return field;
+}
+
+bool next_int(std::string_view &line, int &out) {
+  std::string_view field = next_field(line);
+  auto [ptr, ec] =
+      std::from_chars(field.data(), field.data() + field.size(), out);
+  return ec == std::errc() && ptr == field.data() + field.size() &&
+         !field.empty();
+}
+
+struct Shared {
+  Index index;
+  std::string directory;
+};
+
+const Shared &shared() {
+  static const Shared atlas = [] {
+    Shared loaded;
+    std::string path =
+        afterhours::files::get_resource_path("atlas", "atlas.txt").string();
+    mapped_file::MappedFile file;
+    // A missing atlas is fine, sprites then load one file each
+    if (!resource_pack::open(file, path))
+      return loaded;
+    std::string_view text(reinterpret_cast<const char *>(file.data()),
+                          file.size());
+    if (!loaded.index.parse(text)) {
+      log_warn("[sprite_atlas] Ignoring malformed {}", path);
+      return loaded;
+    }
+    loaded.directory =
+        afterhours::files::get_resource_path("atlas", "").string();
+    return loaded;
+  }();
+  return atlas;
+}
+
+// The loose file for key, split into the group/name files:: expects
+std::string loose_path(const std::string &key) {
+  size_t slash = key.rfind('/');
+  if (slash == std::string::npos)
+    return afterhours::files::get_resource_path("", key).string();
+  return afterhours::files::get_resource_path(key.substr(0, slash),
+                                              key.substr(slash + 1))
+      .string();
+}
+
+} // namespace
+
+bool Index::parse(std::string_view text) {
+  pages_.clear();
+  regions_.clear();
+  while (!text.empty()) {
+    size_t end = text.find('\n');
+    std::string_view line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    if (!line.empty() && line.back() == '\r')
+      line.remove_suffix(1);
+
+    std::string_view kind = next_field(line);
+    if (kind.empty() || kind.front() == '#')
+      continue;
+    bool ok = false;
+    if (kind == "page") {
+      std::string_view file = next_field(line);
+      int width = 0, height = 0;
+      ok = !file.empty() && next_int(line, width) && next_int(line, height);
+      if (ok)
+        pages_.emplace_back(file);
+    } else if (kind == "sprite") {
+      std::string_view key = next_field(line);
+      int page = 0, x = 0, y = 0, width = 0, height = 0;
+      ok = !key.empty() && next_int(line, page) && next_int(line, x) &&
+           next_int(line, y) && next_int(line, width) &&
+           next_int(line, height) && page >= 0 &&
+           page < static_cast<int>(pages_.size());
+      if (ok) {
+        regions_[std::string(key)] = Region{
+            page, raylib::Rectangle{static_cast<float>(x),
+                                    static_cast<float>(y),
+                                    static_cast<float>(width),
+                                    static_cast<float>(height)}};
+      }
+    }
+    if (!ok || !next_field(line).empty()) {
+      pages_.clear();
+      regions_.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+const Region *Index::find(std::string_view key) const {
+  auto it = regions_.find(std::string(key));
+  return it == regions_.end() ? nullptr : &it->second;
+}
+
+std::vector<std::string> files_for(std::span<const char *const> keys) {
+  const Shared &atlas = shared();
+  std::vector<std::string> files;
+  for (const char *key : keys) {
+    const Region *region = atlas.index.find(key);
+    std::string file = region
+                           ? atlas.directory + atlas.index.pages()[region->page]
+                           : loose_path(key);
+    if (std::find(files.begin(), files.end(), file) == files.end())
+      files.push_back(std::move(file));
+  }
+  return files;
+}
+
+Sprite load(texture_cache::TextureSet &textures, const std::string &key) {
+  const Shared &atlas = shared();
+  Sprite sprite;
+  if (const Region *region = atlas.index.find(key)) {
+    sprite.texture =
+        textures.load(atlas.directory + atlas.index.pages()[region->page]);
+    sprite.source = region->source;
+    if (sprite)
+      return sprite;
+  }
+  sprite.texture = textures.load(loose_path(key));
+  sprite.source = raylib::Rectangle{0, 0,
+                                    static_cast<float>(sprite.texture.width),
+                                    static_cast<float>(sprite.texture.height)};
+  return sprite;
+}
+
+} // namespace sprite_atlas
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../rl.h"
+#include "texture_cache.h"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sprite_atlas {
+
+// A texture and the part of it to draw
+struct Sprite {
+  raylib::Texture2D texture{};
+  raylib::Rectangle source{};
+
+  explicit operator bool() const { return texture.id != 0; }
+};
+
+struct Region {
+  int page = 0;
+  raylib::Rectangle source{};
+};
+
+// Lookup table written by scripts/pack_atlas.py:
+//   page <file> <width> <height>
+//   sprite <resource relative path> <page> <x> <y> <width> <height>
+class Index {
+public:
+  // Returns false and stays empty if any line is malformed
+  bool parse(std::string_view text);
+
+  const Region *find(std::string_view key) const;
+  const std::vector<std::string> &pages() const { return pages_; }
+  size_t size() const { return regions_.size(); }
+
+private:
+  std::vector<std::string> pages_;
+  std::unordered_map<std::string, Region> regions_;
+};
+
+// Resolves a sprite by its path under resources/, e.g.
+// "images/icon_uav.png", to its region of the packed atlas (run
+// `make atlas`), holding the page through textures so it is released with
+// the screen. Sprites that were not packed load from their own file.
+// Repeat lookups hit textures, so this is cheap enough to call per frame.
+Sprite load(texture_cache::TextureSet &textures, const std::string &key);
+// The files load() reads for these sprites, without duplicates, for
+// prefetching
+std::vector<std::string> files_for(std::span<const char *const> keys);
+
+} // namespace sprite_atlas
@@ -0,0 +1,144 @@
+#include "startup_graph.h"
+
+#include "trace.h"
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace startup {
+
+TaskGraph::TaskId TaskGraph::add(std::string name, Affinity affinity,
+                                 std::function<void()> fn,
+                                 std::vector<TaskId> deps) {
+  TaskId id = static_cast<TaskId>(tasks_.size());
+  Task task;
+  task.name = std::move(name);
+  task.affinity = affinity;
+  task.fn = std::move(fn);
+  task.pending = static_cast<int>(deps.size());
+  tasks_.push_back(std::move(task));
+  for (TaskId dep : deps) {
+    tasks_[dep].dependents.push_back(id);
+  }
+  return id;
+}
+
+void TaskGraph::run() {
+  run_start_ = std::chrono::steady_clock::now();
+  if (tasks_.empty()) {
+    run_end_ = run_start_;
+    return;
+  }
+
+  std::mutex mutex;
+  std::condition_variable main_wakeup;
+  std::deque<TaskId> main_ready;
+  size_t remaining = tasks_.size();
+
+  const size_t threads = std::clamp<size_t>(
+      std::thread::hardware_concurrency() > 1
+          ? std::thread::hardware_concurrency() - 1
+          : 1,
+      1, 8);
+  worker_pool::WorkerPool pool(threads, tasks_.size());
+
+  std::function<void(TaskId)> schedule;
+  // Runs a task, then releases its dependents. Called with no lock held.
+  auto execute = [&](TaskId id) {
+    Task &task = tasks_[id];
+    task.start = std::chrono::steady_clock::now();
+    {
+      TRACE_ZONE(trace::intern(task.name));
+      task.fn();
+    }
+    task.end = std::chrono::steady_clock::now();
+
+    std::vector<TaskId> ready;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (TaskId dependent : task.dependents) {
+        if (--tasks_[dependent].pending == 0) {
+          ready.push_back(dependent);
+        }
+      }
+      remaining--;
+    }
+    for (TaskId next : ready) {
+      schedule(next);
+    }
+    main_wakeup.notify_one();
+  };
+  schedule = [&](TaskId id) {
+    if (tasks_[id].affinity == Affinity::Worker) {
+      pool.submit([&execute, id] { execute(id); });
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      main_ready.push_back(id);
+    }
+    main_wakeup.notify_one();
+  };
+
+  for (TaskId id = 0; id < static_cast<TaskId>(tasks_.size()); id++) {
+    if (tasks_[id].pending == 0) {
+      schedule(id);
+    }
+  }
+
+  // The calling thread owns the GL context, so it drains main-thread tasks
+  while (true) {
+    TaskId id = -1;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      main_wakeup.wait(lock,
+                       [&] { return remaining == 0 || !main_ready.empty(); });
+      if (main_ready.empty())
+        break;
+      id = main_ready.front();
+      main_ready.pop_front();
+    }
+    execute(id);
+  }
+  pool.flush();
+  run_end_ = std::chrono::steady_clock::now();
+}
+
+void TaskGraph::print_stats(std::ostream &out) const {
+  auto ms = [this](std::chrono::steady_clock::time_point t) {
+    return std::chrono::duration<double, std::milli>(t - run_start_).count();
+  };
+
+  std::vector<const Task *> order;
+  for (const Task &task : tasks_) {
+    order.push_back(&task);
+  }
+  std::sort(order.begin(), order.end(), [](const Task *a, const Task *b) {
+    return a->start < b->start;
+  });
+
+  double busy = 0.0;
+  out << "Startup tasks:\n";
+  for (const Task *task : order) {
+    char line[256];
+    double duration = ms(task->end) - ms(task->start);
+    busy += duration;
+    std::snprintf(line, sizeof(line), "  %-28s %-6s %8.1f -> %8.1f  %8.1f ms\n",
+                  task->name.c_str(),
+                  task->affinity == Affinity::Main ? "main" : "worker",
+                  ms(task->start), ms(task->end), duration);
+    out << line;
+  }
+  char total[128];
+  std::snprintf(total, sizeof(total),
+                "  total %.1f ms wall, %.1f ms of task time\n", ms(run_end_),
+                busy);
+  out << total;
+}
+
+} // namespace startup
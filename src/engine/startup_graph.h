@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace startup {
+
+// Where a task may run. GL, window and ECS work must stay on the main thread.
+enum class Affinity { Worker, Main };
+
+// A small dependency graph of startup tasks. Worker tasks run on a thread
+// pool while the calling thread executes main-thread tasks as soon as their
+// dependencies finish.
+class TaskGraph {
+public:
+  using TaskId = int;
+
+  TaskId add(std::string name, Affinity affinity, std::function<void()> fn,
+             std::vector<TaskId> deps = {});
+
+  // Runs every task and returns once all have finished
+  void run();
+
+  // Per task start/end offsets and durations, in dependency order
+  void print_stats(std::ostream &out) const;
+
+private:
+  struct Task {
+    std::string name;
+    Affinity affinity;
+    std::function<void()> fn;
+    std::vector<TaskId> dependents;
+    int pending = 0;
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+  };
+
+  std::vector<Task> tasks_;
+  std::chrono::steady_clock::time_point run_start_;
+  std::chrono::steady_clock::time_point run_end_;
+};
+
+} // namespace startup
@@ -0,0 +1,308 @@
+#include "texture_cache.h"
+
+#include "resource_pack.h"
+#include "worker_pool.h"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace texture_cache {
+
+namespace {
+
+// Room for the textures of a few recently closed screens
+constexpr size_t DEFAULT_IDLE_BUDGET = 64 * 1024 * 1024;
+
+const raylib::Texture2D EMPTY_TEXTURE{};
+
+size_t texture_bytes(const raylib::Texture2D &texture) {
+  if (texture.id == 0)
+    return 0;
+  return static_cast<size_t>(raylib::GetPixelDataSize(
+      texture.width, texture.height, texture.format));
+}
+
+// An image decoded by prefetch(), waiting for its first acquire
+struct Decoded {
+  raylib::Image image{};
+  bool done = false;
+  // Dropped while decoding, the worker frees it
+  bool dropped = false;
+};
+
+struct Prefetches {
+  std::mutex mutex;
+  std::condition_variable decoded;
+  std::unordered_map<std::string, Decoded> images;
+};
+
+Prefetches &prefetches() {
+  // Leaked so decode jobs finishing during exit never see it destroyed
+  static Prefetches *state = new Prefetches();
+  return *state;
+}
+
+worker_pool::WorkerPool &decode_pool() {
+  static worker_pool::WorkerPool pool(2, 64);
+  return pool;
+}
+
+// Decodes straight from the resource pack when the file is packed
+raylib::Image decode_image(const std::string &path) {
+  std::span<const uint8_t> packed = resource_pack::find(path);
+  if (packed.empty()) {
+    return raylib::LoadImage(path.c_str());
+  }
+  return raylib::LoadImageFromMemory(raylib::GetFileExtension(path.c_str()),
+                                     packed.data(),
+                                     static_cast<int>(packed.size()));
+}
+
+// Takes the prefetched image for path, waiting if it is still decoding
+bool take_prefetched(const std::string &path, raylib::Image &out) {
+  Prefetches &state = prefetches();
+  std::unique_lock<std::mutex> lock(state.mutex);
+  auto it = state.images.find(path);
+  if (it == state.images.end())
+    return false;
+  state.decoded.wait(lock, [&] {
+    it = state.images.find(path);
+    return it == state.images.end() || it->second.done;
+  });
+  if (it == state.images.end())
+    return false;
+  out = it->second.image;
+  state.images.erase(it);
+  return out.data != nullptr;
+}
+
+raylib::Texture2D load_texture(const char *path) {
+  raylib::Image image{};
+  if (!take_prefetched(path, image)) {
+    image = decode_image(path);
+  }
+  raylib::Texture2D texture = raylib::LoadTextureFromImage(image);
+  raylib::UnloadImage(image);
+  return texture;
+}
+
+void unload_texture(raylib::Texture2D texture) {
+  raylib::UnloadTexture(texture);
+}
+
+} // namespace
+
+Handle::Handle(Cache *cache, CacheEntry *entry)
+    : cache_(cache), entry_(entry) {
+  cache_->add_ref(entry_);
+}
+
+Handle::~Handle() { release(); }
+
+Handle::Handle(const Handle &other)
+    : cache_(other.cache_), entry_(other.entry_) {
+  if (entry_)
+    cache_->add_ref(entry_);
+}
+
+Handle &Handle::operator=(const Handle &other) {
+  if (this != &other) {
+    if (other.entry_)
+      other.cache_->add_ref(other.entry_);
+    release();
+    cache_ = other.cache_;
+    entry_ = other.entry_;
+  }
+  return *this;
+}
+
+Handle::Handle(Handle &&other) noexcept
+    : cache_(other.cache_), entry_(other.entry_) {
+  other.cache_ = nullptr;
+  other.entry_ = nullptr;
+}
+
+Handle &Handle::operator=(Handle &&other) noexcept {
+  if (this != &other) {
+    release();
+    cache_ = other.cache_;
+    entry_ = other.entry_;
+    other.cache_ = nullptr;
+    other.entry_ = nullptr;
+  }
+  return *this;
+}
+
+const raylib::Texture2D &Handle::get() const {
+  return entry_ ? entry_->texture : EMPTY_TEXTURE;
+}
+
+void Handle::release() {
+  if (entry_)
+    cache_->release(entry_);
+  cache_ = nullptr;
+  entry_ = nullptr;
+}
+
+Cache::Cache(LoadFn load, UnloadFn unload, size_t idle_budget)
+    : load_(load), unload_(unload), idle_budget_(idle_budget) {}
+
+Cache::~Cache() { unload_all(); }
+
+Handle Cache::acquire(const std::string &path) {
+  auto it = entries_.find(path);
+  if (it != entries_.end()) {
+    hits_++;
+    return Handle(this, &it->second);
+  }
+  misses_++;
+  CacheEntry &entry = entries_[path];
+  entry.path = path;
+  // Failed loads are cached too, so a missing file is only reported once
+  if (!unloaded_) {
+    entry.texture = load_(path.c_str());
+  }
+  entry.bytes = texture_bytes(entry.texture);
+  return Handle(this, &entry);
+}
+
+void Cache::add_ref(CacheEntry *entry) {
+  if (entry->refs++ == 0 && entry->idle) {
+    idle_.erase(entry->idle_it);
+    idle_bytes_ -= entry->bytes;
+    entry->idle = false;
+  }
+}
+
+void Cache::release(CacheEntry *entry) {
+  if (--entry->refs > 0 || unloaded_)
+    return;
+  entry->idle_it = idle_.insert(idle_.end(), entry);
+  entry->idle = true;
+  idle_bytes_ += entry->bytes;
+  evict_to_budget();
+}
+
+void Cache::evict_to_budget() {
+  while (idle_bytes_ > idle_budget_ && !idle_.empty()) {
+    CacheEntry *entry = idle_.front();
+    idle_.pop_front();
+    idle_bytes_ -= entry->bytes;
+    if (entry->texture.id != 0) {
+      unload_(entry->texture);
+    }
+    evictions_++;
+    entries_.erase(entry->path);
+  }
+}
+
+void Cache::set_idle_budget(size_t bytes) {
+  idle_budget_ = bytes;
+  evict_to_budget();
+}
+
+Stats Cache::stats() const {
+  Stats stats;
+  stats.textures = entries_.size();
+  stats.idle_bytes = idle_bytes_;
+  stats.hits = hits_;
+  stats.misses = misses_;
+  stats.evictions = evictions_;
+  for (const auto &[path, entry] : entries_) {
+    if (entry.refs > 0)
+      stats.referenced++;
+    stats.resident_bytes += entry.bytes;
+  }
+  return stats;
+}
+
+void Cache::unload_all() {
+  if (unloaded_)
+    return;
+  for (auto &[path, entry] : entries_) {
+    if (entry.texture.id != 0) {
+      unload_(entry.texture);
+    }
+    entry.texture = raylib::Texture2D{};
+    entry.bytes = 0;
+  }
+  // Entries with live handles must stay, the rest can go
+  std::erase_if(entries_, [](const auto &kv) { return kv.second.refs == 0; });
+  idle_.clear();
+  idle_bytes_ = 0;
+  unloaded_ = true;
+}
+
+Cache &shared() {
+  // Never destroyed, Preload unloads it before the window closes
+  static Cache *cache =
+      new Cache(load_texture, unload_texture, DEFAULT_IDLE_BUDGET);
+  return *cache;
+}
+
+void unload_all() { shared().unload_all(); }
+
+void prefetch(const std::string &path) {
+  if (shared().contains(path))
+    return;
+  Prefetches &state = prefetches();
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto [it, inserted] = state.images.try_emplace(path);
+    if (!inserted) {
+      it->second.dropped = false;
+      return;
+    }
+  }
+  decode_pool().submit([path] {
+    raylib::Image image = decode_image(path);
+    Prefetches &shared_state = prefetches();
+    std::lock_guard<std::mutex> lock(shared_state.mutex);
+    auto it = shared_state.images.find(path);
+    if (it == shared_state.images.end() || it->second.dropped) {
+      raylib::UnloadImage(image);
+      if (it != shared_state.images.end())
+        shared_state.images.erase(it);
+    } else {
+      it->second.image = image;
+      it->second.done = true;
+    }
+    shared_state.decoded.notify_all();
+  });
+}
+
+bool prefetched(const std::vector<std::string> &paths) {
+  Prefetches &state = prefetches();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  for (const std::string &path : paths) {
+    auto it = state.images.find(path);
+    if (it != state.images.end() && !it->second.done)
+      return false;
+  }
+  return true;
+}
+
+void drop_prefetched(const std::vector<std::string> &paths) {
+  Prefetches &state = prefetches();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  for (const std::string &path : paths) {
+    auto it = state.images.find(path);
+    if (it == state.images.end())
+      continue;
+    if (it->second.done) {
+      raylib::UnloadImage(it->second.image);
+      state.images.erase(it);
+    } else {
+      it->second.dropped = true;
+    }
+  }
+}
+
+raylib::Texture2D TextureSet::load(const std::string &path) {
+  auto it = handles_.find(path);
+  if (it == handles_.end())
+    it = handles_.emplace(path, acquire(path)).first;
+  return it->second.get();
+}
+
+} // namespace texture_cache
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "../rl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace texture_cache {
+
+class Cache;
+
+struct CacheEntry {
+  std::string path;
+  raylib::Texture2D texture{};
+  size_t bytes = 0;
+  int refs = 0;
+  // Position in the idle list while refs == 0
+  std::list<CacheEntry *>::iterator idle_it;
+  bool idle = false;
+};
+
+// Counted reference to a cached texture. The texture stays loaded while any
+// handle to it exists; after that it is kept around until the idle budget
+// forces it out.
+class Handle {
+public:
+  Handle() = default;
+  ~Handle();
+
+  Handle(const Handle &other);
+  Handle &operator=(const Handle &other);
+  Handle(Handle &&other) noexcept;
+  Handle &operator=(Handle &&other) noexcept;
+
+  // A zeroed texture for empty handles and files that failed to load
+  const raylib::Texture2D &get() const;
+  explicit operator bool() const { return get().id != 0; }
+
+private:
+  friend class Cache;
+
+  Handle(Cache *cache, CacheEntry *entry);
+  void release();
+
+  Cache *cache_ = nullptr;
+  CacheEntry *entry_ = nullptr;
+};
+
+struct Stats {
+  size_t textures = 0;
+  size_t referenced = 0;
+  size_t resident_bytes = 0;
+  size_t idle_bytes = 0;
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;
+};
+
+// Textures keyed by resource path. Main thread only, like all GL calls.
+class Cache {
+public:
+  using LoadFn = raylib::Texture2D (*)(const char *path);
+  using UnloadFn = void (*)(raylib::Texture2D texture);
+
+  Cache(LoadFn load, UnloadFn unload, size_t idle_budget);
+  ~Cache();
+
+  Cache(const Cache &) = delete;
+  Cache &operator=(const Cache &) = delete;
+
+  Handle acquire(const std::string &path);
+  bool contains(const std::string &path) const {
+    return entries_.contains(path);
+  }
+
+  // Bytes of unreferenced textures kept for reuse before evicting the least
+  // recently released ones
+  void set_idle_budget(size_t bytes);
+  Stats stats() const;
+
+  // Unloads every texture; later releases of live handles become no-ops
+  void unload_all();
+
+private:
+  friend class Handle;
+  void add_ref(CacheEntry *entry);
+  void release(CacheEntry *entry);
+  void evict_to_budget();
+
+  LoadFn load_;
+  UnloadFn unload_;
+  size_t idle_budget_;
+  std::unordered_map<std::string, CacheEntry> entries_;
+  // Unreferenced entries, least recently released first
+  std::list<CacheEntry *> idle_;
+  size_t idle_bytes_ = 0;
+  size_t hits_ = 0;
+  size_t misses_ = 0;
+  size_t evictions_ = 0;
+  bool unloaded_ = false;
+};
+
+// Process-wide cache reading from the resource pack or loose files
+Cache &shared();
+inline Handle acquire(const std::string &path) {
+  return shared().acquire(path);
+}
+// Must run while the GL context is still alive
+void unload_all();
+
+// Decodes the file on a worker thread so the shared cache only has to
+// upload it when it is first acquired. Files that are already resident or
+// queued are skipped.
+void prefetch(const std::string &path);
+// True once none of the paths is still being decoded
+bool prefetched(const std::vector<std::string> &paths);
+// Frees decoded images for paths that will not be acquired after all
+void drop_prefetched(const std::vector<std::string> &paths);
+
+// Keeps the handles a screen uses alive for the screen's lifetime, so the
+// screen can store plain raylib textures as before. Loading a path again
+// returns the texture it already holds.
+class TextureSet {
+public:
+  raylib::Texture2D load(const std::string &path);
+
+private:
+  std::unordered_map<std::string, Handle> handles_;
+};
+
+} // namespace texture_cache
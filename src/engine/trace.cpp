@@ -0,0 +1,180 @@
+#include "trace.h"
+
+#include "../log.h"
+#include "json_writer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace trace {
+
+namespace {
+
+struct Event {
+  const char *name;
+  uint64_t start_ns;
+  uint64_t end_ns;
+  char phase;
+};
+
+constexpr size_t CHUNK_EVENTS = 4096;
+
+// Filled by one thread and read by stop(); count is published after the
+// event is written so the reader never sees a partial event
+struct Chunk {
+  Event events[CHUNK_EVENTS];
+  std::atomic<size_t> count{0};
+  std::atomic<Chunk *> next{nullptr};
+};
+
+// Buffers are never freed, a thread's events outlive the thread
+struct ThreadBuffer {
+  uint32_t tid = 0;
+  std::atomic<const char *> name{nullptr};
+  Chunk *head = nullptr;
+  Chunk *tail = nullptr;
+  ThreadBuffer *next = nullptr;
+};
+
+std::atomic<bool> g_enabled{false};
+std::atomic<ThreadBuffer *> g_buffers{nullptr};
+std::atomic<uint32_t> g_next_tid{1};
+std::string g_path;
+const auto g_epoch = std::chrono::steady_clock::now();
+
+ThreadBuffer &thread_buffer() {
+  thread_local ThreadBuffer *buffer = [] {
+    auto *created = new ThreadBuffer();
+    created->tid = g_next_tid.fetch_add(1);
+    created->head = created->tail = new Chunk();
+    created->next = g_buffers.load(std::memory_order_relaxed);
+    while (!g_buffers.compare_exchange_weak(created->next, created,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+    }
+    return created;
+  }();
+  return *buffer;
+}
+
+void record(const Event &event) {
+  ThreadBuffer &buffer = thread_buffer();
+  Chunk *chunk = buffer.tail;
+  size_t index = chunk->count.load(std::memory_order_relaxed);
+  if (index == CHUNK_EVENTS) {
+    auto *fresh = new Chunk();
+    chunk->next.store(fresh, std::memory_order_release);
+    buffer.tail = chunk = fresh;
+    index = 0;
+  }
+  chunk->events[index] = event;
+  chunk->count.store(index + 1, std::memory_order_release);
+}
+
+double to_us(uint64_t ns) { return static_cast<double>(ns) / 1000.0; }
+
+} // namespace
+
+uint64_t now_ns() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - g_epoch)
+          .count());
+}
+
+void start(const std::string &path) {
+  g_path = path;
+  g_enabled.store(true, std::memory_order_release);
+  set_thread_name("main");
+}
+
+bool enabled() { return g_enabled.load(std::memory_order_relaxed); }
+
+const char *intern(const std::string &name) {
+  static std::mutex mutex;
+  static std::unordered_set<std::string> names;
+  std::lock_guard<std::mutex> lock(mutex);
+  return names.insert(name).first->c_str();
+}
+
+void set_thread_name(const char *name) {
+  thread_buffer().name.store(name, std::memory_order_release);
+}
+
+void begin(const char *name) {
+  if (enabled())
+    record(Event{name, now_ns(), 0, 'B'});
+}
+
+void end(const char *name) {
+  if (enabled())
+    record(Event{name, now_ns(), 0, 'E'});
+}
+
+void complete(const char *name, uint64_t start_ns, uint64_t end_ns) {
+  record(Event{name, start_ns, end_ns, 'X'});
+}
+
+bool stop() {
+  if (!g_enabled.exchange(false))
+    return false;
+
+  std::string json;
+  json_writer::JsonWriter out(json);
+  out.begin_object();
+  out.key("traceEvents");
+  out.begin_array();
+  for (ThreadBuffer *buffer = g_buffers.load(std::memory_order_acquire);
+       buffer != nullptr; buffer = buffer->next) {
+    if (const char *name = buffer->name.load(std::memory_order_acquire)) {
+      out.begin_object();
+      out.field("name", "thread_name");
+      out.field("ph", "M");
+      out.field("pid", 1);
+      out.field("tid", static_cast<uint64_t>(buffer->tid));
+      out.key("args");
+      out.begin_object();
+      out.field("name", name);
+      out.end_object();
+      out.end_object();
+    }
+    for (Chunk *chunk = buffer->head; chunk != nullptr;
+         chunk = chunk->next.load(std::memory_order_acquire)) {
+      size_t count = chunk->count.load(std::memory_order_acquire);
+      for (size_t i = 0; i < count; i++) {
+        const Event &event = chunk->events[i];
+        out.begin_object();
+        out.field("name", event.name);
+        out.key("ph");
+        out.value(std::string_view(&event.phase, 1));
+        out.field("ts", to_us(event.start_ns));
+        if (event.phase == 'X')
+          out.field("dur", to_us(event.end_ns - event.start_ns));
+        out.field("pid", 1);
+        out.field("tid", static_cast<uint64_t>(buffer->tid));
+        out.end_object();
+      }
+    }
+  }
+  out.end_array();
+  out.field("displayTimeUnit", "ms");
+  out.end_object();
+
+  FILE *file = std::fopen(g_path.c_str(), "wb");
+  if (file == nullptr) {
+    log_error("[trace] Could not open {}", g_path);
+    return false;
+  }
+  bool ok = std::fwrite(json.data(), 1, json.size(), file) == json.size();
+  ok = std::fclose(file) == 0 && ok;
+  if (!ok) {
+    log_error("[trace] Could not write {}", g_path);
+  }
+  return ok;
+}
+
+} // namespace trace
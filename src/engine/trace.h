@@ -0,0 +1,81 @@
+#pragma once
+
+// Scoped-zone profiler that writes Chrome trace-event JSON (open the file
+// in chrome://tracing or ui.perfetto.dev). Build with ENABLE_TRACE=1 and run
+// with --trace-out=<file>. Without AFTER_HOURS_ENABLE_TRACE the macros
+// compile to nothing.
+
+#include <cstdint>
+#include <string>
+
+namespace trace {
+
+// Starts recording; events are written to path by stop()
+void start(const std::string &path);
+// Writes the trace file. Threads may still be recording, their events up
+// to this point are included.
+bool stop();
+bool enabled();
+
+// Returns a copy of name that lives until exit, for zones whose names are
+// built at runtime
+const char *intern(const std::string &name);
+void set_thread_name(const char *name);
+
+void begin(const char *name);
+void end(const char *name);
+void complete(const char *name, uint64_t start_ns, uint64_t end_ns);
+uint64_t now_ns();
+
+class Zone {
+public:
+  explicit Zone(const char *name)
+      : name_(enabled() ? name : nullptr), start_(name_ ? now_ns() : 0) {}
+  ~Zone() {
+    if (name_)
+      complete(name_, start_, now_ns());
+  }
+
+  Zone(const Zone &) = delete;
+  Zone &operator=(const Zone &) = delete;
+
+private:
+  const char *name_;
+  uint64_t start_;
+};
+
+// Starts a trace for the lifetime of main() if a path was given
+class Session {
+public:
+  explicit Session(const std::string &path) : active_(!path.empty()) {
+    if (active_)
+      start(path);
+  }
+  ~Session() {
+    if (active_)
+      stop();
+  }
+
+  Session(const Session &) = delete;
+  Session &operator=(const Session &) = delete;
+
+private:
+  bool active_;
+};
+
+} // namespace trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef AFTER_HOURS_ENABLE_TRACE
+#define TRACE_ZONE(name) trace::Zone TRACE_CONCAT(trace_zone_, __LINE__)(name)
+#define TRACE_BEGIN(name) trace::begin(name)
+#define TRACE_END(name) trace::end(name)
+#define TRACE_THREAD_NAME(name) trace::set_thread_name(name)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -0,0 +1,69 @@
+#include "worker_pool.h"
+
+#include "trace.h"
+
+#include <algorithm>
+
+namespace worker_pool {
+
+WorkerPool::WorkerPool(size_t num_threads, size_t max_queued)
+    : max_queued_(std::max<size_t>(max_queued, 1)) {
+  num_threads = std::max<size_t>(num_threads, 1);
+  workers_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; i++) {
+    workers_.emplace_back([this] { worker_loop(); });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  has_work_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+void WorkerPool::submit(Job job) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  has_space_.wait(lock, [this] { return queue_.size() < max_queued_; });
+  queue_.push_back(std::move(job));
+  lock.unlock();
+  has_work_.notify_one();
+}
+
+void WorkerPool::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  idle_.wait(lock, [this] { return queue_.empty() && active_ == 0; });
+}
+
+void WorkerPool::worker_loop() {
+  TRACE_THREAD_NAME("worker");
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      has_work_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      // Drain the queue before honoring a stop request
+      if (queue_.empty())
+        return;
+      job = std::move(queue_.front());
+      queue_.pop_front();
+      active_++;
+    }
+    has_space_.notify_one();
+
+    job();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      active_--;
+      if (queue_.empty() && active_ == 0)
+        idle_.notify_all();
+    }
+  }
+}
+
+} // namespace worker_pool
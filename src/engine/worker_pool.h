@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace worker_pool {
+
+// Fixed set of worker threads fed by a bounded FIFO queue. submit() blocks
+// while the queue is full so producers cannot outrun the workers.
+class WorkerPool {
+public:
+  using Job = std::function<void()>;
+
+  WorkerPool(size_t num_threads, size_t max_queued);
+  // Finishes all queued jobs before joining the workers
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  void submit(Job job);
+
+  // Blocks until every job submitted so far has finished
+  void flush();
+
+  size_t thread_count() const { return workers_.size(); }
+
+private:
+  void worker_loop();
+
+  std::mutex mutex_;
+  std::condition_variable has_work_;
+  std::condition_variable has_space_;
+  std::condition_variable idle_;
+  std::deque<Job> queue_;
+  size_t max_queued_;
+  size_t active_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace worker_pool
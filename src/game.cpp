@@ -1,22 +1,31 @@
 #include "game.h"
 
 #include "components.h"
+#include "engine/debug_name.h"
+#include "engine/font_registry.h"
+#include "engine/frame_stats.h"
 #include "input_mapping.h"
 #include "log.h"
 #include "preload.h"
 #include "render_backend.h"
 #include "settings.h"
 #include "systems/ExampleScreenRegistry.h"
+#include "systems/IdleDetector.h"
 #include "systems/RenderRenderTexture.h"
 #include "systems/RenderScreenHUD.h"
 #include "systems/RenderSystemHelpers.h"
 #include "systems/RenderTestFeedback.h"
+#include "systems/RenderUIDebug.h"
+#include "systems/ScreenPrewarmer.h"
 #include "systems/SetupSimpleButtonTest.h"
 #include "systems/SetupTabbingTest.h"
 #include "systems/TestSystem.h"
+#include "systems/TracedSystem.h"
+#include "systems/UpdateGlyphAtlas.h"
 #include "systems/UpdateRenderTexture.h"
 #include "testing/e2e_integration.h"
 #include "testing/screenshot_validation.h"
+#include "testing/screenshot_writer.h"
 #include "testing/test_app.h"
 #include "testing/test_input.h"
 #include "testing/test_macros.h"
@@ -50,72 +59,196 @@ static void configure_validation() {
 
 #ifdef AFTER_HOURS_ENABLE_MCP
 #include "engine/input_injector.h"
+#include "engine/json_writer.h"
+#include "engine/screenshot_encoder.h"
 #include <afterhours/src/plugins/mcp_server.h>
-#include <nlohmann/json.hpp>
-#include <sstream>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
 
 #ifdef AFTER_HOURS_ENABLE_MCP
 extern bool g_mcp_mode;
+extern bool g_mcp_tree_delta;
+extern screenshot_encoder::Options g_mcp_screenshot_options;
 extern int g_saved_stdout_fd;
 #endif
 
 namespace {
 
-// Build JSON representation of UI component tree
-nlohmann::json build_ui_tree_json(afterhours::Entity &entity,
-                                  afterhours::ui::UIComponent &cmp) {
-  nlohmann::json node;
-  node["id"] = cmp.id;
+// Per-node change tracking for the UI tree dump. A node's version is the
+// tree version at which its rect, visibility or label last changed.
+struct UINodeVersion {
+  uint64_t signature = 0;
+  uint64_t version = 0;
+  uint64_t seen_serial = 0;
+};
 
-  if (entity.has<afterhours::ui::UIComponentDebug>()) {
-    node["name"] = entity.get<afterhours::ui::UIComponentDebug>().name();
+struct UITreeVersions {
+  std::unordered_map<afterhours::EntityID, UINodeVersion> nodes;
+  // Nodes that vanished since the last full dump, with the tree version
+  // they vanished in
+  std::unordered_map<afterhours::EntityID, uint64_t> removed;
+  uint64_t tree_version = 0;
+  uint64_t serial = 0;
+  bool changed = false;
+};
+
+UITreeVersions ui_tree_versions;
+
+uint64_t fnv1a(uint64_t hash, const void *data, size_t size) {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
   }
+  return hash;
+}
 
-  node["rect"] = {{"x", cmp.rect().x},
-                  {"y", cmp.rect().y},
-                  {"width", cmp.rect().width},
-                  {"height", cmp.rect().height}};
+std::string_view label_of(afterhours::Entity &entity) {
+  if (entity.has<afterhours::ui::HasLabel>()) {
+    return entity.get<afterhours::ui::HasLabel>().label;
+  }
+  return {};
+}
 
-  node["computed"] = {{"width", cmp.computed[afterhours::ui::Axis::X]},
-                      {"height", cmp.computed[afterhours::ui::Axis::Y]}};
+// Records this dump's view of the node and returns its version
+uint64_t touch_node(afterhours::Entity &entity,
+                    afterhours::ui::UIComponent &cmp) {
+  raylib::Rectangle rect = cmp.rect();
+  bool visible = cmp.was_rendered_to_screen;
+  std::string_view label = label_of(entity);
+
+  uint64_t signature = 14695981039346656037ull;
+  signature = fnv1a(signature, &rect, sizeof(rect));
+  signature = fnv1a(signature, &visible, sizeof(visible));
+  signature = fnv1a(signature, label.data(), label.size());
+
+  auto [it, inserted] = ui_tree_versions.nodes.try_emplace(cmp.id);
+  UINodeVersion &node = it->second;
+  node.seen_serial = ui_tree_versions.serial;
+  if (inserted || node.signature != signature) {
+    node.signature = signature;
+    node.version = ui_tree_versions.tree_version + 1;
+    ui_tree_versions.changed = true;
+    ui_tree_versions.removed.erase(cmp.id);
+  }
+  return node.version;
+}
 
-  node["relative_pos"] = {{"x", cmp.computed_rel[afterhours::ui::Axis::X]},
-                          {"y", cmp.computed_rel[afterhours::ui::Axis::Y]}};
+afterhours::ui::UIComponent *child_component(afterhours::EntityID child_id,
+                                             afterhours::Entity *&child_ent) {
+  afterhours::OptEntity opt =
+      afterhours::EntityHelper::getEntityForID(child_id);
+  if (!opt.has_value())
+    return nullptr;
+  child_ent = &opt.asE();
+  if (!child_ent->has<afterhours::ui::UIComponent>())
+    return nullptr;
+  return &child_ent->get<afterhours::ui::UIComponent>();
+}
 
-  node["padding"] = {
-      {"left", cmp.computed_padd[afterhours::ui::Axis::left]},
-      {"top", cmp.computed_padd[afterhours::ui::Axis::top]},
-      {"right", cmp.computed_padd[afterhours::ui::Axis::right]},
-      {"bottom", cmp.computed_padd[afterhours::ui::Axis::bottom]}};
+void write_axes(json_writer::JsonWriter &json, std::string_view name,
+                const afterhours::ui::UIComponent &cmp, bool margin) {
+  const auto &values = margin ? cmp.computed_margin : cmp.computed_padd;
+  json.key(name);
+  json.begin_object();
+  json.field("left", values[afterhours::ui::Axis::left]);
+  json.field("top", values[afterhours::ui::Axis::top]);
+  json.field("right", values[afterhours::ui::Axis::right]);
+  json.field("bottom", values[afterhours::ui::Axis::bottom]);
+  json.end_object();
+}
 
-  node["margin"] = {
-      {"left", cmp.computed_margin[afterhours::ui::Axis::left]},
-      {"top", cmp.computed_margin[afterhours::ui::Axis::top]},
-      {"right", cmp.computed_margin[afterhours::ui::Axis::right]},
-      {"bottom", cmp.computed_margin[afterhours::ui::Axis::bottom]}};
+// Writes the node and its whole subtree, refreshing versions on the way
+void write_ui_node(json_writer::JsonWriter &json, afterhours::Entity &entity,
+                   afterhours::ui::UIComponent &cmp) {
+  uint64_t version = touch_node(entity, cmp);
 
-  node["absolute"] = cmp.absolute;
-  node["visible"] = cmp.was_rendered_to_screen;
+  json.begin_object();
+  json.field("id", static_cast<int64_t>(cmp.id));
+  json.field("version", version);
+  if (entity.has<afterhours::ui::UIComponentDebug>()) {
+    json.field("name", entity.get<afterhours::ui::UIComponentDebug>().name());
+  }
+  std::string_view label = label_of(entity);
+  if (!label.empty()) {
+    json.field("label", label);
+  }
 
-  // Add children recursively
-  nlohmann::json children_arr = nlohmann::json::array();
+  raylib::Rectangle rect = cmp.rect();
+  json.key("rect");
+  json.begin_object();
+  json.field("x", rect.x);
+  json.field("y", rect.y);
+  json.field("width", rect.width);
+  json.field("height", rect.height);
+  json.end_object();
+
+  json.key("computed");
+  json.begin_object();
+  json.field("width", cmp.computed[afterhours::ui::Axis::X]);
+  json.field("height", cmp.computed[afterhours::ui::Axis::Y]);
+  json.end_object();
+
+  json.key("relative_pos");
+  json.begin_object();
+  json.field("x", cmp.computed_rel[afterhours::ui::Axis::X]);
+  json.field("y", cmp.computed_rel[afterhours::ui::Axis::Y]);
+  json.end_object();
+
+  write_axes(json, "padding", cmp, false);
+  write_axes(json, "margin", cmp, true);
+
+  json.field("absolute", cmp.absolute);
+  json.field("visible", cmp.was_rendered_to_screen);
+
+  json.key("children");
+  json.begin_array();
   for (afterhours::EntityID child_id : cmp.children) {
-    try {
-      auto &child_ent = afterhours::ui::AutoLayout::to_ent_static(child_id);
-      auto &child_cmp = afterhours::ui::AutoLayout::to_cmp_static(child_id);
-      children_arr.push_back(build_ui_tree_json(child_ent, child_cmp));
-    } catch (...) {
-      // Skip invalid children
+    afterhours::Entity *child_ent = nullptr;
+    if (auto *child_cmp = child_component(child_id, child_ent)) {
+      write_ui_node(json, *child_ent, *child_cmp);
     }
   }
-  node["children"] = children_arr;
+  json.end_array();
+  json.end_object();
+}
 
-  return node;
+// Delta walk: emits the top-most nodes that changed after `since` as full
+// subtrees and only descends through nodes that did not change
+void write_ui_changes(json_writer::JsonWriter &json, afterhours::Entity &entity,
+                      afterhours::ui::UIComponent &cmp,
+                      const afterhours::ui::UIComponent *parent,
+                      uint64_t since) {
+  uint64_t version = touch_node(entity, cmp);
+  if (version > since) {
+    json.begin_object();
+    json.key("parent");
+    if (parent) {
+      json.value(static_cast<int64_t>(parent->id));
+    } else {
+      json.null();
+    }
+    json.key("node");
+    write_ui_node(json, entity, cmp);
+    json.end_object();
+    return;
+  }
+  for (afterhours::EntityID child_id : cmp.children) {
+    afterhours::Entity *child_ent = nullptr;
+    if (auto *child_cmp = child_component(child_id, child_ent)) {
+      write_ui_changes(json, *child_ent, *child_cmp, &cmp, since);
+    }
+  }
 }
 
-std::string dump_ui_tree() {
-  nlohmann::json result;
-  result["tree"] = nlohmann::json::array();
+// Dumps the UI tree as compact JSON. since == 0 writes the whole tree,
+// otherwise only subtrees that changed after tree version `since` plus the
+// ids of nodes removed since then.
+std::string dump_ui_tree_since(uint64_t since) {
+  UITreeVersions &state = ui_tree_versions;
+  state.serial++;
+  state.changed = false;
 
   // Find all root UI components (those with AutoLayoutRoot)
   auto roots = afterhours::EntityQuery()
@@ -123,36 +256,88 @@ std::string dump_ui_tree() {
                    .whereHasComponent<afterhours::ui::UIComponent>()
                    .gen();
 
+  std::string body;
+  body.reserve(since == 0 ? 64 * 1024 : 4 * 1024);
+  json_writer::JsonWriter json(body);
+  json.begin_array();
   for (auto &entity_ref : roots) {
     afterhours::Entity &entity = entity_ref.get();
     auto &cmp = entity.get<afterhours::ui::UIComponent>();
-    result["tree"].push_back(build_ui_tree_json(entity, cmp));
+    if (since == 0) {
+      write_ui_node(json, entity, cmp);
+    } else {
+      write_ui_changes(json, entity, cmp, nullptr, since);
+    }
+  }
+  json.end_array();
+
+  // Anything not visited this dump is gone
+  for (auto it = state.nodes.begin(); it != state.nodes.end();) {
+    if (it->second.seen_serial != state.serial) {
+      state.removed[it->first] = state.tree_version + 1;
+      state.changed = true;
+      it = state.nodes.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (state.changed) {
+    state.tree_version++;
   }
 
-  return result.dump(2); // Pretty print with 2-space indent
-}
-
-std::vector<uint8_t> capture_screenshot_png() {
-  raylib::Image image = raylib::LoadImageFromTexture(mainRT.texture);
-  if (image.data == nullptr) {
-    return {};
+  std::string result;
+  result.reserve(body.size() + 128);
+  json_writer::JsonWriter out(result);
+  out.begin_object();
+  out.field("tree_version", state.tree_version);
+  if (since == 0) {
+    out.key("tree");
+    out.raw(body);
+  } else {
+    out.field("since", since);
+    out.key("changed");
+    out.raw(body);
+    out.key("removed");
+    out.begin_array();
+    for (const auto &[id, removed_in] : state.removed) {
+      if (removed_in > since) {
+        out.value(static_cast<int64_t>(id));
+      }
+    }
+    out.end_array();
   }
-  raylib::ImageFlipVertical(&image);
+  out.end_object();
+  // Deltas up to the next full dump may still need these
+  if (since == 0) {
+    state.removed.clear();
+  }
+  return result;
+}
 
-  int file_size = 0;
-  unsigned char *png_data =
-      raylib::ExportImageToMemory(image, ".png", &file_size);
-  raylib::UnloadImage(image);
+// With --mcp-tree-delta, every FULL_TREE_INTERVAL-th dump is a full tree
+constexpr int FULL_TREE_INTERVAL = 32;
 
-  if (png_data == nullptr || file_size <= 0) {
-    return {};
+std::string dump_ui_tree() {
+  // Deltas carry everything changed since the last full tree, not since
+  // the previous call, so a client that drops a response applies the next
+  // one as usual. One that missed the full tree itself resyncs at the next.
+  static uint64_t full_version = 0;
+  static int dumps_since_full = 0;
+  const bool full = !g_mcp_tree_delta || dumps_since_full == 0;
+  std::string result = dump_ui_tree_since(full ? 0 : full_version);
+  if (full) {
+    full_version = ui_tree_versions.tree_version;
   }
-
-  std::vector<uint8_t> result(png_data, png_data + file_size);
-  raylib::MemFree(png_data);
+  dumps_since_full = (dumps_since_full + 1) % FULL_TREE_INTERVAL;
   return result;
 }
 
+std::vector<uint8_t> capture_screenshot() {
+  TRACE_ZONE("capture_screenshot");
+  static screenshot_encoder::Encoder encoder;
+  return encoder.capture(mainRT, g_mcp_screenshot_options);
+}
+
 void init_mcp() {
   if (!g_mcp_mode) {
     return;
@@ -163,7 +348,7 @@ void init_mcp() {
     return std::make_pair(Settings::get().get_screen_width(),
                           Settings::get().get_screen_height());
   };
-  config.capture_screenshot = capture_screenshot_png;
+  config.capture_screenshot = capture_screenshot;
   config.mouse_move = [](int x, int y) {
     input_injector::set_mouse_position(x, y);
   };
@@ -184,6 +369,8 @@ void init_mcp() {
 
 bool running = true;
 raylib::RenderTexture2D mainRT;
+// Ping-pong target for post_fx, which allocates it only while a chain
+// needs it
 raylib::RenderTexture2D screenRT;
 raylib::Font uiFont;
 
@@ -193,12 +380,10 @@ void game() {
 
   mainRT = raylib::LoadRenderTexture(Settings::get().get_screen_width(),
                                      Settings::get().get_screen_height());
-  screenRT = raylib::LoadRenderTexture(Settings::get().get_screen_width(),
-                                       Settings::get().get_screen_height());
-  uiFont = afterhours::load_font_from_file(
+  // Same atlas Preload registered as the default font
+  uiFont = font_registry::load_ui_font(
       afterhours::files::get_resource_path("fonts", "Gaegu-Bold.ttf")
-          .string()
-          .c_str());
+          .string());
 
   afterhours::SystemManager systems;
 
@@ -213,37 +398,45 @@ void game() {
   TestSystem *test_system_ptr = nullptr;
 
   {
+    trace_update_group(systems, "afterhours update", true);
     afterhours::input::register_update_systems(systems);
     afterhours::window_manager::register_update_systems(systems);
     afterhours::toast::register_update_systems(systems);
     afterhours::toast::register_layout_systems<InputAction>(systems);
     afterhours::modal::register_update_systems<InputAction>(systems);
+    trace_update_group(systems, "afterhours update", false);
 
     auto test_system = std::make_unique<TestSystem>();
     test_system_ptr = test_system.get();
-    systems.register_update_system(std::move(test_system));
+    systems.register_update_system(
+        traced(std::move(test_system), "TestSystem"));
   }
 
   {
-    systems.register_render_system(std::make_unique<BeginWorldRender>());
+    systems.register_render_system(TRACED_SYSTEM(UpdateGlyphAtlas));
+    systems.register_render_system(TRACED_SYSTEM(BeginWorldRender));
+    trace_render_group(systems, "afterhours ui render", true);
     afterhours::modal::register_render_systems<InputAction>(systems);
     afterhours::ui::register_render_systems<InputAction>(
         systems, InputAction::ToggleUILayoutDebug);
-    systems.register_render_system(std::make_unique<EndWorldRender>());
-    systems.register_render_system(
-        std::make_unique<BeginPostProcessingRender>());
-    systems.register_render_system(std::make_unique<RenderRenderTexture>());
-    systems.register_render_system(std::make_unique<EndDrawing>());
+    trace_render_group(systems, "afterhours ui render", false);
+    systems.register_render_system(TRACED_SYSTEM(EndWorldRender));
+    systems.register_render_system(TRACED_SYSTEM(BeginPostProcessingRender));
+    systems.register_render_system(TRACED_SYSTEM(RenderRenderTexture));
+    systems.register_render_system(TRACED_SYSTEM(RenderUIDebug));
+    systems.register_render_system(TRACED_SYSTEM(EndDrawing));
   }
 
   afterhours::ui::validation::register_systems<InputAction>(systems);
 
   while (running && !raylib::WindowShouldClose()) {
+    TRACE_ZONE("frame");
     if (raylib::IsKeyPressed(raylib::KEY_ESCAPE)) {
       running = false;
     }
     float dt = raylib::GetFrameTime();
     systems.run(dt);
+    frame_stats::end_frame();
 
     if (test_system_ptr && test_system_ptr->is_complete()) {
       std::string error = test_system_ptr->get_error();
@@ -275,12 +468,10 @@ void run_test(const std::string &test_name, bool slow_mode, bool hold_on_end) {
 
   mainRT = raylib::LoadRenderTexture(Settings::get().get_screen_width(),
                                      Settings::get().get_screen_height());
-  screenRT = raylib::LoadRenderTexture(Settings::get().get_screen_width(),
-                                       Settings::get().get_screen_height());
-  uiFont = afterhours::load_font_from_file(
+  // Same atlas Preload registered as the default font
+  uiFont = font_registry::load_ui_font(
       afterhours::files::get_resource_path("fonts", "Gaegu-Bold.ttf")
-          .string()
-          .c_str());
+          .string());
 
   afterhours::SystemManager systems;
 
@@ -295,20 +486,25 @@ void run_test(const std::string &test_name, bool slow_mode, bool hold_on_end) {
   TestSystem *test_system_ptr = nullptr;
 
   {
+    trace_update_group(systems, "afterhours update", true);
     afterhours::input::register_update_systems(systems);
     afterhours::window_manager::register_update_systems(systems);
     afterhours::toast::register_update_systems(systems);
     afterhours::toast::register_layout_systems<InputAction>(systems);
     afterhours::modal::register_update_systems<InputAction>(systems);
+    trace_update_group(systems, "afterhours update", false);
 
-    systems.register_update_system(std::make_unique<UpdateRenderTexture>());
+    systems.register_update_system(TRACED_SYSTEM(UpdateRenderTexture));
 
     auto test_system = std::make_unique<TestSystem>();
     test_system_ptr = test_system.get();
-    systems.register_update_system(std::move(test_system));
+    systems.register_update_system(
+        traced(std::move(test_system), "TestSystem"));
 
     // Register UI pre-update systems (clears, resets)
+    trace_update_group(systems, "ui before updates", true);
     afterhours::ui::register_before_ui_updates<InputAction>(systems);
+    trace_update_group(systems, "ui before updates", false);
 
     // Register the test UI so buttons exist when processed
     // Check if test name starts with a registered screen name
@@ -320,7 +516,7 @@ void run_test(const std::string &test_name, bool slow_mode, bool hold_on_end) {
         if (screen) {
           // Set as current screen so ScreenSystem runs
           g_current_screen = screen.get();
-          systems.register_update_system(std::move(screen));
+          systems.register_update_system(traced(std::move(screen), "screen"));
           screen_found = true;
           break;
         }
@@ -330,30 +526,33 @@ void run_test(const std::string &test_name, bool slow_mode, bool hold_on_end) {
     if (!screen_found) {
       // Fall back to built-in test setups
       if (test_name == "tabbing") {
-        systems.register_update_system(std::make_unique<SetupTabbingTest>());
+        systems.register_update_system(TRACED_SYSTEM(SetupTabbingTest));
       } else {
-        systems.register_update_system(
-            std::make_unique<SetupSimpleButtonTest>());
+        systems.register_update_system(TRACED_SYSTEM(SetupSimpleButtonTest));
       }
     }
 
     // Register UI post-update systems (HandleClicks, HandleTabbing, layout,
     // etc.)
+    trace_update_group(systems, "ui after updates", true);
     afterhours::ui::register_after_ui_updates<InputAction>(systems);
+    trace_update_group(systems, "ui after updates", false);
   }
 
   {
-    systems.register_render_system(std::make_unique<BeginWorldRender>());
+    systems.register_render_system(TRACED_SYSTEM(UpdateGlyphAtlas));
+    systems.register_render_system(TRACED_SYSTEM(BeginWorldRender));
+    trace_render_group(systems, "afterhours ui render", true);
     afterhours::modal::register_render_systems<InputAction>(systems);
     afterhours::ui::register_render_systems<InputAction>(
         systems, InputAction::ToggleUILayoutDebug);
-    systems.register_render_system(std::make_unique<EndWorldRender>());
-    systems.register_render_system(
-        std::make_unique<BeginPostProcessingRender>());
-    systems.register_render_system(std::make_unique<RenderRenderTexture>());
+    trace_render_group(systems, "afterhours ui render", false);
+    systems.register_render_system(TRACED_SYSTEM(EndWorldRender));
+    systems.register_render_system(TRACED_SYSTEM(BeginPostProcessingRender));
+    systems.register_render_system(TRACED_SYSTEM(RenderRenderTexture));
 
-    systems.register_render_system(std::make_unique<RenderTestFeedback>());
-    systems.register_render_system(std::make_unique<EndDrawing>());
+    systems.register_render_system(TRACED_SYSTEM(RenderTestFeedback));
+    systems.register_render_system(TRACED_SYSTEM(EndDrawing));
   }
 
   afterhours::ui::validation::register_systems<InputAction>(systems);
@@ -362,6 +561,7 @@ void run_test(const std::string &test_name, bool slow_mode, bool hold_on_end) {
   test_system_ptr->set_test(test_name, std::move(test));
 
   while (running && !raylib::WindowShouldClose()) {
+    TRACE_ZONE("frame");
     if (raylib::IsKeyPressed(raylib::KEY_ESCAPE)) {
       running = false;
     }
@@ -393,6 +593,8 @@ void run_test(const std::string &test_name, bool slow_mode, bool hold_on_end) {
       }
     }
   }
+
+  screenshot_writer::flush();
 }
 
 struct ScreenCyclerSystem : afterhours::System<> {
@@ -445,23 +647,38 @@ struct ScreenCyclerSystem : afterhours::System<> {
   }
 };
 
-void run_screen_demo(const std::string &screen_name, bool /* hold_on_end */) {
+// Shows the last mainRT again without running any systems
+static void present_last_frame() {
+  render_backend::BeginDrawing();
+  render_backend::ClearBackground(raylib::BLACK);
+  RenderRenderTexture{}.once(0.f);
+  RenderScreenHUD{}.once(0.f);
+  render_backend::EndDrawing();
+}
+
+void run_screen_demo(const std::string &screen_name, bool /* hold_on_end */,
+                     int prewarm_radius) {
   configure_validation();
 
   mainRT = raylib::LoadRenderTexture(Settings::get().get_screen_width(),
                                      Settings::get().get_screen_height());
-  screenRT = raylib::LoadRenderTexture(Settings::get().get_screen_width(),
-                                       Settings::get().get_screen_height());
 
-  uiFont = afterhours::load_font_from_file(
+  // Same atlas Preload registered as the default font
+  uiFont = font_registry::load_ui_font(
       afterhours::files::get_resource_path("fonts", "Gaegu-Bold.ttf")
-          .string()
-          .c_str());
+          .string());
 
 #ifdef AFTER_HOURS_ENABLE_MCP
   init_mcp();
 #endif
 
+  // Suffixed element names are only read through MCP here
+#ifdef AFTER_HOURS_ENABLE_MCP
+  debug_name::set_enabled(g_mcp_mode);
+#else
+  debug_name::set_enabled(false);
+#endif
+
   std::vector<std::string> screen_names =
       ExampleScreenRegistry::get().get_screen_names();
   if (screen_names.empty()) {
@@ -488,26 +705,31 @@ void run_screen_demo(const std::string &screen_name, bool /* hold_on_end */) {
   }
 
   {
+    trace_update_group(systems, "afterhours update", true);
     afterhours::input::register_update_systems(systems);
     afterhours::window_manager::register_update_systems(systems);
     afterhours::toast::register_update_systems(systems);
     afterhours::toast::register_layout_systems<InputAction>(systems);
     afterhours::modal::register_update_systems<InputAction>(systems);
+    trace_update_group(systems, "afterhours update", false);
 
-    systems.register_update_system(std::make_unique<UpdateRenderTexture>());
+    systems.register_update_system(TRACED_SYSTEM(UpdateRenderTexture));
   }
 
   {
-    systems.register_render_system(std::make_unique<BeginWorldRender>());
+    systems.register_render_system(TRACED_SYSTEM(UpdateGlyphAtlas));
+    systems.register_render_system(TRACED_SYSTEM(BeginWorldRender));
+    trace_render_group(systems, "afterhours ui render", true);
     afterhours::modal::register_render_systems<InputAction>(systems);
     afterhours::ui::register_render_systems<InputAction>(
         systems, InputAction::ToggleUILayoutDebug);
-    systems.register_render_system(std::make_unique<EndWorldRender>());
-    systems.register_render_system(
-        std::make_unique<BeginPostProcessingRender>());
-    systems.register_render_system(std::make_unique<RenderRenderTexture>());
-    systems.register_render_system(std::make_unique<RenderScreenHUD>());
-    systems.register_render_system(std::make_unique<EndDrawing>());
+    trace_render_group(systems, "afterhours ui render", false);
+    systems.register_render_system(TRACED_SYSTEM(EndWorldRender));
+    systems.register_render_system(TRACED_SYSTEM(BeginPostProcessingRender));
+    systems.register_render_system(TRACED_SYSTEM(RenderRenderTexture));
+    systems.register_render_system(TRACED_SYSTEM(RenderScreenHUD));
+    systems.register_render_system(TRACED_SYSTEM(RenderUIDebug));
+    systems.register_render_system(TRACED_SYSTEM(EndDrawing));
   }
 
   // Initialize HUD state
@@ -518,8 +740,17 @@ void run_screen_demo(const std::string &screen_name, bool /* hold_on_end */) {
       std::make_unique<ScreenCyclerSystem>();
   cycler_system->systems_ptr = &systems;
   ScreenCyclerSystem *cycler_ptr = cycler_system.get();
+  ScreenPrewarmer prewarmer(screen_names, prewarm_radius);
+  // MCP drives the demo with injected input and screenshots, which need
+  // every frame rendered
+#ifdef AFTER_HOURS_ENABLE_MCP
+  IdleDetector idle(!g_mcp_mode);
+#else
+  IdleDetector idle(true);
+#endif
 
   auto load_screen = [&](int index) {
+    TRACE_ZONE("load_screen");
     if (index < 0 || index >= static_cast<int>(screen_names.size())) {
       return;
     }
@@ -542,8 +773,8 @@ void run_screen_demo(const std::string &screen_name, bool /* hold_on_end */) {
     }
 
     std::string new_screen_name = screen_names[index];
-    current_screen_system =
-        ExampleScreenRegistry::get().create_screen(new_screen_name);
+    idle.wake();
+    current_screen_system = prewarmer.take(index);
     if (!current_screen_system) {
       std::cerr << "ERROR: Failed to create screen: " << new_screen_name
                 << std::endl;
@@ -570,7 +801,9 @@ void run_screen_demo(const std::string &screen_name, bool /* hold_on_end */) {
   };
 
   {
+    trace_update_group(systems, "ui before updates", true);
     afterhours::ui::register_before_ui_updates<InputAction>(systems);
+    trace_update_group(systems, "ui before updates", false);
 
     load_screen(current_screen_index);
     if (!current_screen_system) {
@@ -578,14 +811,17 @@ void run_screen_demo(const std::string &screen_name, bool /* hold_on_end */) {
                 << std::endl;
       return;
     }
-    systems.register_update_system(std::move(cycler_system));
+    systems.register_update_system(traced(std::move(cycler_system), "screen"));
 
+    trace_update_group(systems, "ui after updates", true);
     afterhours::ui::register_after_ui_updates<InputAction>(systems);
+    trace_update_group(systems, "ui after updates", false);
   }
 
   afterhours::ui::validation::register_systems<InputAction>(systems);
 
   while (running && !raylib::WindowShouldClose()) {
+    TRACE_ZONE("frame");
 #ifdef AFTER_HOURS_ENABLE_MCP
     if (g_mcp_mode) {
       // Process any pending input injections BEFORE systems run
@@ -618,7 +854,15 @@ void run_screen_demo(const std::string &screen_name, bool /* hold_on_end */) {
     }
 
     float dt = raylib::GetFrameTime();
+    if (idle.idle(g_current_screen, dt)) {
+      TRACE_ZONE("idle frame");
+      present_last_frame();
+      prewarmer.update(current_screen_index);
+      continue;
+    }
     systems.run(dt);
+    prewarmer.update(current_screen_index);
+    frame_stats::end_frame();
 
 #ifdef AFTER_HOURS_ENABLE_MCP
     if (g_mcp_mode) {
@@ -642,6 +886,8 @@ void run_screen_demo(const std::string &screen_name, bool /* hold_on_end */) {
 
 int run_e2e_tests(const e2e::E2EArgs &args,
                   afterhours::testing::E2ERunner &runner) {
+  constexpr float HEADLESS_FRAME_DT = 1.0f / 60.0f;
+
   configure_validation();
 
   // Set global update-baselines flag
@@ -657,13 +903,11 @@ int run_e2e_tests(const e2e::E2EArgs &args,
 
   mainRT = raylib::LoadRenderTexture(Settings::get().get_screen_width(),
                                      Settings::get().get_screen_height());
-  screenRT = raylib::LoadRenderTexture(Settings::get().get_screen_width(),
-                                       Settings::get().get_screen_height());
 
-  uiFont = afterhours::load_font_from_file(
+  // Same atlas Preload registered as the default font
+  uiFont = font_registry::load_ui_font(
       afterhours::files::get_resource_path("fonts", "Gaegu-Bold.ttf")
-          .string()
-          .c_str());
+          .string());
 
   std::vector<std::string> screen_names =
       ExampleScreenRegistry::get().get_screen_names();
@@ -685,25 +929,32 @@ int run_e2e_tests(const e2e::E2EArgs &args,
   }
 
   {
+    trace_update_group(systems, "afterhours update", true);
     afterhours::input::register_update_systems(systems);
     afterhours::window_manager::register_update_systems(systems);
     afterhours::toast::register_update_systems(systems);
     afterhours::toast::register_layout_systems<InputAction>(systems);
     afterhours::modal::register_update_systems<InputAction>(systems);
-    systems.register_update_system(std::make_unique<UpdateRenderTexture>());
+    trace_update_group(systems, "afterhours update", false);
+    systems.register_update_system(TRACED_SYSTEM(UpdateRenderTexture));
   }
 
   {
-    systems.register_render_system(std::make_unique<BeginWorldRender>());
+    systems.register_render_system(TRACED_SYSTEM(UpdateGlyphAtlas));
+    systems.register_render_system(TRACED_SYSTEM(BeginWorldRender));
+    trace_render_group(systems, "afterhours ui render", true);
     afterhours::modal::register_render_systems<InputAction>(systems);
     afterhours::ui::register_render_systems<InputAction>(
         systems, InputAction::ToggleUILayoutDebug);
-    systems.register_render_system(std::make_unique<EndWorldRender>());
-    systems.register_render_system(
-        std::make_unique<BeginPostProcessingRender>());
-    systems.register_render_system(std::make_unique<RenderRenderTexture>());
-    systems.register_render_system(std::make_unique<RenderScreenHUD>());
-    systems.register_render_system(std::make_unique<EndDrawing>());
+    trace_render_group(systems, "afterhours ui render", false);
+    systems.register_render_system(TRACED_SYSTEM(EndWorldRender));
+    // Headless runs only need mainRT (for screenshots), not the window blit
+    if (!args.headless) {
+      systems.register_render_system(TRACED_SYSTEM(BeginPostProcessingRender));
+      systems.register_render_system(TRACED_SYSTEM(RenderRenderTexture));
+      systems.register_render_system(TRACED_SYSTEM(RenderScreenHUD));
+      systems.register_render_system(TRACED_SYSTEM(EndDrawing));
+    }
   }
 
   // Initialize HUD state
@@ -716,6 +967,7 @@ int run_e2e_tests(const e2e::E2EArgs &args,
   ScreenCyclerSystem *cycler_ptr = cycler_system.get();
 
   auto load_screen = [&](int index) {
+    TRACE_ZONE("load_screen");
     if (index < 0 || index >= static_cast<int>(screen_names.size())) {
       return;
     }
@@ -754,16 +1006,20 @@ int run_e2e_tests(const e2e::E2EArgs &args,
   };
 
   {
+    trace_update_group(systems, "ui before updates", true);
     afterhours::ui::register_before_ui_updates<InputAction>(systems);
+    trace_update_group(systems, "ui before updates", false);
 
     load_screen(current_screen_index);
     if (!current_screen_system) {
       std::cerr << "ERROR: Failed to create initial screen" << std::endl;
       return 1;
     }
-    systems.register_update_system(std::move(cycler_system));
+    systems.register_update_system(traced(std::move(cycler_system), "screen"));
 
+    trace_update_group(systems, "ui after updates", true);
     afterhours::ui::register_after_ui_updates<InputAction>(systems);
+    trace_update_group(systems, "ui after updates", false);
   }
 
   // Reset callback for per-script cleanup
@@ -916,7 +1172,7 @@ int run_e2e_tests(const e2e::E2EArgs &args,
           [](const std::string &name) {
             std::string path = "/tmp/e2e_screenshot_" + name + ".png";
             screenshot_validation::save_screenshot_to(path);
-            log_info("[E2E] Screenshot saved: {}", path);
+            log_info("[E2E] Screenshot queued: {}", path);
           }));
 
   // Register validate_screen command for visual regression testing
@@ -934,14 +1190,33 @@ int run_e2e_tests(const e2e::E2EArgs &args,
 
   afterhours::ui::validation::register_systems<InputAction>(systems);
 
+  auto has_pending_command = []() {
+    // Commands from runner.tick() are not merged into the entity list yet
+    afterhours::EntityHelper::merge_entity_arrays();
+    for (afterhours::Entity &entity :
+         afterhours::EntityQuery()
+             .whereHasComponent<afterhours::testing::PendingE2ECommand>()
+             .gen()) {
+      auto &cmd = entity.get<afterhours::testing::PendingE2ECommand>();
+      if (!cmd.is_consumed() && !cmd.is("wait")) {
+        return true;
+      }
+    }
+    return false;
+  };
+  bool rendered_last_frame = true;
+
   // Main E2E loop with visual rendering
   while (running && !raylib::WindowShouldClose() && !runner.is_finished()) {
+    TRACE_ZONE("frame");
     if (raylib::IsKeyPressed(raylib::KEY_ESCAPE)) {
       running = false;
       break;
     }
 
-    float dt = raylib::GetFrameTime();
+    // Headless runs simulate a steady 60Hz so waits and timeouts do not
+    // depend on how fast frames are produced
+    float dt = args.headless ? HEADLESS_FRAME_DT : raylib::GetFrameTime();
 
     // Advance E2E runner (dispatches commands)
     runner.tick(dt);
@@ -950,7 +1225,22 @@ int run_e2e_tests(const e2e::E2EArgs &args,
     // Note: E2E handlers (update) run first, then rendering populates registry
     // The visible text registry accumulates text from render; expect_text
     // checks in the next frame after rendering has populated it
-    systems.run(dt);
+    if (!args.fast_forward) {
+      systems.run(dt);
+    } else {
+      // Frames with no command in flight (e.g. `wait`) only advance time.
+      // Before a command runs, catch up with one render so screenshots,
+      // validate_screen and expect_text see the same state as a full run.
+      bool has_command = has_pending_command();
+      if (has_command && !rendered_last_frame) {
+        systems.render_all(dt);
+      }
+      systems.tick_all(dt);
+      if (has_command) {
+        systems.render_all(dt);
+      }
+      rendered_last_frame = has_command;
+    }
 
     // Fail fast on first error
     if (afterhours::testing::get_command_error_count() > 0) {
@@ -977,10 +1267,22 @@ int run_e2e_tests(const e2e::E2EArgs &args,
 
     // Reset test input state for next frame
     afterhours::testing::test_input::reset_frame();
+
+    // EndDrawing normally polls window events; keep the window alive when
+    // it does not run
+    if (args.headless || !rendered_last_frame) {
+      raylib::PollInputEvents();
+    }
   }
 
+  // Let queued screenshots land before reporting
+  screenshot_writer::flush();
+
   runner.print_results();
-  Settings::get().write_save_file();
+  // Parallel workers share one save file with the coordinator's other children
+  if (!args.worker) {
+    Settings::get().write_save_file();
+  }
 
   return runner.has_failed() ? 1 : 0;
 }
@@ -6,6 +6,8 @@ backward::SignalHandling sh;
 #endif
 
 #include "argh.h"
+#include "engine/post_fx.h"
+#include "engine/trace.h"
 #include "game.h"
 #include "preload.h"
 #include "settings.h"
@@ -62,6 +64,7 @@ backward::SignalHandling sh;
 #include "systems/screens/TabContainerShowcase.h"
 #include "systems/screens/ToastShowcase.h"
 #include "testing/e2e_integration.h"
+#include "testing/e2e_parallel.h"
 #include "testing/test_macros.h"
 #include "testing/tests/all_tests.h"
 #include <cstdio>
@@ -69,6 +72,7 @@ backward::SignalHandling sh;
 
 #ifdef AFTER_HOURS_ENABLE_MCP
 #include "engine/input_injector.h"
+#include "engine/screenshot_encoder.h"
 #include <afterhours/src/plugins/mcp_server.h>
 #ifndef _WIN32
 #include <unistd.h>
@@ -79,9 +83,32 @@ using namespace afterhours;
 
 #ifdef AFTER_HOURS_ENABLE_MCP
 bool g_mcp_mode = false;
+bool g_mcp_tree_delta = false; // dump_ui_tree returns changes since a full dump
+screenshot_encoder::Options g_mcp_screenshot_options;
 int g_saved_stdout_fd = -1; // Used by MCP to write JSON to original stdout
 #endif
 
+static StartupOptions startup_options(argh::parser &cmdl) {
+  StartupOptions options;
+  cmdl({"-w", "--width"}, 1280) >> options.width;
+  cmdl({"-h", "--height"}, 720) >> options.height;
+  options.print_stats = cmdl["--startup-stats"];
+  return options;
+}
+
+// --post-fx replaces the saved pass list for this run only
+static void apply_post_fx_flag(argh::parser &cmdl) {
+  std::string list;
+  if (!(cmdl({"--post-fx"}) >> list))
+    return;
+  std::vector<post_fx::Pass> passes;
+  if (!post_fx::parse(list, passes)) {
+    std::cerr << "Unknown --post-fx pass in '" << list << "', ignoring\n";
+    return;
+  }
+  post_fx::set_chain(std::move(passes));
+}
+
 int main(int argc, char *argv[]) {
   argh::parser cmdl(argc, argv, argh::parser::PREFER_PARAM_FOR_UNREG_OPTION);
 
@@ -97,8 +124,39 @@ int main(int argc, char *argv[]) {
     dup2(STDERR_FILENO, STDOUT_FILENO);
 #endif
   }
+  g_mcp_tree_delta = cmdl["--mcp-tree-delta"];
+
+  std::string screenshot_format;
+  if (cmdl({"--mcp-screenshot-format"}) >> screenshot_format &&
+      !screenshot_encoder::parse_format(screenshot_format,
+                                        g_mcp_screenshot_options.format)) {
+    std::cerr << "Unknown --mcp-screenshot-format '" << screenshot_format
+              << "', using png\n";
+  }
+  std::string screenshot_region;
+  if (cmdl({"--mcp-screenshot-region"}) >> screenshot_region &&
+      !screenshot_encoder::parse_region(screenshot_region,
+                                        g_mcp_screenshot_options.region)) {
+    std::cerr << "Invalid --mcp-screenshot-region '" << screenshot_region
+              << "', expected x,y,width,height\n";
+  }
+  cmdl({"--mcp-screenshot-scale"}, 1) >> g_mcp_screenshot_options.scale;
+  g_mcp_screenshot_options.skip_unchanged =
+      cmdl["--mcp-screenshot-skip-unchanged"];
 #endif
 
+  std::string trace_path;
+  cmdl({"--trace-out"}) >> trace_path;
+#ifndef AFTER_HOURS_ENABLE_TRACE
+  if (!trace_path.empty()) {
+    std::cerr << "--trace-out needs a build with ENABLE_TRACE=1, ignoring\n";
+    trace_path.clear();
+  }
+#endif
+  // Writes the trace file when main returns
+  trace::Session trace_session(trace_path);
+  TRACE_THREAD_NAME("main");
+
   if (cmdl["--help"]) {
     std::cout << "UI Tester \n\n";
     std::cout << "Usage: ui_tester [OPTIONS]\n\n";
@@ -114,14 +172,39 @@ int main(int argc, char *argv[]) {
         << "  --slow                       Run test in slow mode (visible)\n";
     std::cout << "  --hold-on-end                Keep window open after test "
                  "finishes\n";
+    std::cout << "  --startup-stats              Print startup task timings\n";
+    std::cout << "  --trace-out=<file>           Write a Chrome trace of "
+                 "startup and frames\n"
+                 "                               (needs ENABLE_TRACE=1)\n";
     std::cout << "  --list-screens               List all available example "
                  "screens\n";
     std::cout << "  --screen=<name>              Show example screen (e.g., "
                  "--screen=simple_button)\n";
     std::cout << "                               Navigation: , (prev) . (next) "
                  "PageUp/PageDown\n";
+    std::cout << "  --prewarm=<n>                Screens on each side loaded "
+                 "ahead while cycling\n"
+                 "                               (default: 1, 0 disables)\n";
+    std::cout << "  --post-fx=<passes>           Post processing passes, e.g. "
+                 "bloom,crt,vignette\n"
+                 "                               (default: settings post_fx, "
+                 "none)\n";
 #ifdef AFTER_HOURS_ENABLE_MCP
     std::cout << "  --mcp                        Enable MCP server mode\n";
+    std::cout << "  --mcp-tree-delta             dump_ui_tree returns a full "
+                 "tree every 32 calls and\n"
+                 "                               the changes since it "
+                 "in between\n";
+    std::cout << "  --mcp-screenshot-format <f>  Screenshot encoding: png "
+                 "(default) or fast\n"
+                 "                               (faster, larger png)\n";
+    std::cout << "  --mcp-screenshot-region <r>  Only capture x,y,width,height\n";
+    std::cout << "  --mcp-screenshot-scale <n>   Downscale screenshots by n\n";
+    std::cout << "  --mcp-screenshot-skip-unchanged\n"
+                 "                               Resend the last png without "
+                 "encoding when the\n"
+                 "                               frame matches the last capture\n"
+                 "                               (still a full payload)\n";
 #endif
     std::cout << "\nE2E Testing:\n";
     std::cout << "  --e2e                        Enable E2E test mode\n";
@@ -131,6 +214,11 @@ int main(int argc, char *argv[]) {
     std::cout << "  --slow                       Run tests slowly for visibility (0.5s delay)\n";
     std::cout << "  --slow-delay <seconds>       Set slow mode delay (implies --slow)\n";
     std::cout << "  --update-baselines           Update baseline screenshots instead of comparing\n";
+    std::cout << "  --headless                   Hidden window, no frame cap, fixed 60Hz dt\n";
+    std::cout << "                               (implies --fast-forward)\n";
+    std::cout << "  --fast-forward               Only render frames that a command observes\n";
+    std::cout << "  --jobs <N>                   Run --test-script-dir scripts in N headless\n";
+    std::cout << "                               worker processes\n";
     return 0;
   }
 
@@ -151,22 +239,30 @@ int main(int argc, char *argv[]) {
   // E2E Testing Mode
   if (e2e::should_run_e2e(argc, argv)) {
     auto e2e_args = e2e::parse_e2e_args(argc, argv);
+    if (!e2e_args.error.empty()) {
+      std::cout << e2e_args.error << "\n";
+      return 1;
+    }
     
     if (e2e_args.script_path.empty() && e2e_args.script_dir.empty()) {
       std::cout << "E2E mode requires --test-script or --test-script-dir\n";
       return 1;
     }
 
-    int screenWidth, screenHeight;
-    cmdl({"-w", "--width"}, 1280) >> screenWidth;
-    cmdl({"-h", "--height"}, 720) >> screenHeight;
-
-    Settings::get().load_save_file(screenWidth, screenHeight);
+    // The coordinator only spawns workers, it never opens a window itself
+    if (e2e_args.jobs != 1 && !e2e_args.script_dir.empty()) {
+      if (e2e_parallel::is_supported()) {
+        return e2e_parallel::run_sharded(e2e_args.script_dir, e2e_args.jobs,
+                                         argc, argv);
+      }
+      log_warn("--jobs is not supported on this platform, running serially");
+    }
 
-    Preload::get()
-        .init("UI Tester - E2E Mode")
-        .make_singleton();
-    Settings::get().refresh_settings();
+    StartupOptions startup = startup_options(cmdl);
+    startup.title = "UI Tester - E2E Mode";
+    startup.headless = e2e_args.headless;
+    Preload::get().boot(startup);
+    apply_post_fx_flag(cmdl);
 
     // Set up test mode
     afterhours::testing::test_input::detail::test_mode = true;
@@ -191,11 +287,9 @@ int main(int argc, char *argv[]) {
       return 1;
     }
 
-    std::cout << "Running E2E tests...\n";
+    std::cout << "Running E2E tests" << (e2e_args.headless ? " (headless)" : "")
+              << "...\n";
 
-    // Always run in visual mode - headless mode disabled for debugging
-    // TODO: Re-enable headless mode for CI once debugging is complete
-    // Original condition: if (e2e_args.slow_mode)
     return run_e2e_tests(e2e_args, runner);
   }
 
@@ -209,7 +303,9 @@ int main(int argc, char *argv[]) {
       // argh returns flags without the "--" prefix
       if (arg != "help" && arg != "list-tests" && arg != "list-screens" &&
           arg != "slow" && arg != "hold-on-end" && arg != "run-test" &&
-          arg != "mcp" && arg != "screen") {
+          arg != "startup-stats" && arg != "post-fx" &&
+          arg != "mcp" && arg != "mcp-tree-delta" &&
+          arg != "mcp-screenshot-skip-unchanged" && arg != "screen") {
         // Remove "--" prefix if present (in case it's there)
         if (arg.size() >= 2 && arg[0] == '-' && arg[1] == '-') {
           screen_name = arg.substr(2);
@@ -223,20 +319,14 @@ int main(int argc, char *argv[]) {
 
   if (!screen_name.empty()) {
     if (ExampleScreenRegistry::get().has_screen(screen_name)) {
-      int screenWidth, screenHeight;
-      cmdl({"-w", "--width"}, 1280) >> screenWidth;
-      cmdl({"-h", "--height"}, 720) >> screenHeight;
-
-      Settings::get().load_save_file(screenWidth, screenHeight);
-
-      Preload::get() //
-          .init("UI Tester")
-          .make_singleton();
-      Settings::get().refresh_settings();
+      Preload::get().boot(startup_options(cmdl));
+      apply_post_fx_flag(cmdl);
 
       bool hold_on_end = cmdl["--hold-on-end"];
+      int prewarm = 1;
+      cmdl({"--prewarm"}, 1) >> prewarm;
 
-      run_screen_demo(screen_name, hold_on_end);
+      run_screen_demo(screen_name, hold_on_end, prewarm);
 
       Settings::get().write_save_file();
 
@@ -253,16 +343,8 @@ int main(int argc, char *argv[]) {
     bool slow_mode = cmdl["--slow"];
     bool hold_on_end = cmdl["--hold-on-end"];
 
-    int screenWidth, screenHeight;
-    cmdl({"-w", "--width"}, 1280) >> screenWidth;
-    cmdl({"-h", "--height"}, 720) >> screenHeight;
-
-    Settings::get().load_save_file(screenWidth, screenHeight);
-
-    Preload::get() //
-        .init("UI Tester")
-        .make_singleton();
-    Settings::get().refresh_settings();
+    Preload::get().boot(startup_options(cmdl));
+    apply_post_fx_flag(cmdl);
 
     run_test(test_name, slow_mode, hold_on_end);
 
@@ -279,19 +361,13 @@ int main(int argc, char *argv[]) {
     return 1;
   }
 
-  int screenWidth, screenHeight;
-  cmdl({"-w", "--width"}, 1280) >> screenWidth;
-  cmdl({"-h", "--height"}, 720) >> screenHeight;
-
-  Settings::get().load_save_file(screenWidth, screenHeight);
-
-  Preload::get() //
-      .init("UI Tester")
-      .make_singleton();
-  Settings::get().refresh_settings();
+  Preload::get().boot(startup_options(cmdl));
+  apply_post_fx_flag(cmdl);
 
   bool hold_on_end = cmdl["--hold-on-end"];
-  run_screen_demo(screen_names[0], hold_on_end);
+  int prewarm = 1;
+  cmdl({"--prewarm"}, 1) >> prewarm;
+  run_screen_demo(screen_names[0], hold_on_end, prewarm);
 
   Settings::get().write_save_file();
 
@@ -1,14 +1,26 @@
 #include "preload.h"
 
+#include <array>
 #include <cstdarg>
 #include <cstdio>
+#include <fstream>
 #include <iostream>
-#include <sstream>
+#include <iterator>
+#include <string>
 #include <vector>
 
 #include "log.h"
 #include "rl.h"
 
+#include "engine/font_cache.h"
+#include "engine/font_registry.h"
+#include "engine/glyph_atlas.h"
+#include "engine/gradient_texture.h"
+#include "engine/post_fx.h"
+#include "engine/resource_pack.h"
+#include "engine/startup_graph.h"
+#include "engine/texture_cache.h"
+#include "engine/trace.h"
 #include "input_mapping.h"
 #include "settings.h"
 #include <afterhours/src/plugins/color.h>
@@ -33,164 +45,163 @@ static void mcp_trace_log_callback(int logLevel, const char *text,
 }
 #endif
 
-static void load_gamepad_mappings() {
-  std::ifstream ifs(
-      files::get_resource_path("", "gamecontrollerdb.txt").string().c_str());
+// Reads the whole DB on a worker; applying it needs the window
+static std::string read_gamepad_mappings() {
+  const std::string path =
+      files::get_resource_path("", "gamecontrollerdb.txt").string();
+  std::span<const uint8_t> packed = resource_pack::find(path);
+  if (!packed.empty()) {
+    return std::string(packed.begin(), packed.end());
+  }
+  std::ifstream ifs(path, std::ios::binary);
   if (!ifs.is_open()) {
     log_warn("failed to load game controller db");
-    return;
+    return {};
   }
-  std::stringstream buffer;
-  buffer << ifs.rdbuf();
-  input::set_gamepad_mappings(buffer.str().c_str());
+  return std::string(std::istreambuf_iterator<char>(ifs),
+                     std::istreambuf_iterator<char>());
 }
 
 Preload::Preload() {}
 
-Preload &Preload::init(const char *title) {
-  files::init("Prime Pressure", "resources");
-
+void Preload::open_window(const StartupOptions &options) {
   int width = Settings::get().get_screen_width();
   int height = Settings::get().get_screen_height();
 
-  // In MCP mode, redirect raylib logs to stderr to keep stdout clean for JSON
-#ifdef AFTER_HOURS_ENABLE_MCP
-  if (g_mcp_mode) {
-    raylib::SetTraceLogCallback(mcp_trace_log_callback);
+  // Headless runs still need a GL context to render into mainRT, so use a
+  // hidden window rather than no window at all
+  if (options.headless) {
+    raylib::SetConfigFlags(raylib::FLAG_WINDOW_HIDDEN);
   }
-#endif
-
-  // Set log level BEFORE InitWindow to suppress init messages
-  raylib::SetTraceLogLevel(raylib::LOG_ERROR);
 
-  raylib::InitWindow(width, height, title);
+  raylib::InitWindow(width, height, options.title);
   raylib::SetWindowSize(width, height);
   raylib::SetWindowState(raylib::FLAG_WINDOW_RESIZABLE);
 
-  raylib::SetTargetFPS(200);
+  // 0 disables the frame limiter
+  raylib::SetTargetFPS(options.headless ? 0 : 200);
+  raylib::SetExitKey(0);
+}
 
+void Preload::open_audio() {
   raylib::SetAudioStreamBufferSizeDefault(4096);
   raylib::InitAudioDevice();
   if (!raylib::IsAudioDeviceReady()) {
     log_warn("audio device not ready; continuing without audio");
   }
   raylib::SetMasterVolume(1.f);
+}
 
-  raylib::SetExitKey(0);
+// CJK fonts are rasterized on demand (see glyph_atlas) instead of baking
+// tens of thousands of glyphs at startup. Each atlas starts with ASCII and
+// grows by pages up to this budget, then evicts least recently used glyphs.
+constexpr size_t CJK_ATLAS_BUDGET = 16 * 1024 * 1024;
 
-  load_gamepad_mappings();
+// Hangul Jamo, Compatibility Jamo and Syllables
+static glyph_atlas::Config korean_atlas_config() {
+  glyph_atlas::Config config;
+  config.memory_budget = CJK_ATLAS_BUDGET;
+  config.ranges = {{0x1100, 0x11FF}, {0x3130, 0x318F}, {0xAC00, 0xD7AF}};
+  return config;
+}
 
-  return *this;
+// CJK punctuation, Hiragana, Katakana, Kanji and fullwidth forms
+static glyph_atlas::Config japanese_atlas_config() {
+  glyph_atlas::Config config;
+  config.memory_budget = CJK_ATLAS_BUDGET;
+  config.ranges = {{0x3000, 0x30FF}, {0x4E00, 0x9FFF}, {0xFF00, 0xFFEF}};
+  return config;
 }
 
-// Generate codepoint array for a Unicode range
-static std::vector<int> generate_codepoint_range(int start, int end) {
-  std::vector<int> codepoints;
-  for (int i = start; i <= end; ++i) {
-    codepoints.push_back(i);
+// Registers a dynamic atlas font, falling back to a regular ASCII load
+static void load_dynamic_font(ui::FontManager &fonts, const std::string &name,
+                              const std::string &path,
+                              const glyph_atlas::Config &config) {
+  if (glyph_atlas::DynamicFont *font = glyph_atlas::add(name, path, config)) {
+    fonts.load_font(name, font->font());
+  } else {
+    fonts.load_font(name, font_registry::load_ui_font(path));
+    font_registry::alias(name, font_registry::ui_font_key(path));
   }
-  return codepoints;
 }
 
-// Build codepoints for Korean: Hangul Syllables + Hangul Jamo + ASCII
-static std::vector<int> get_korean_codepoints() {
-  std::vector<int> codepoints;
-  // ASCII (0x0020-0x007F)
-  auto ascii = generate_codepoint_range(0x0020, 0x007F);
-  codepoints.insert(codepoints.end(), ascii.begin(), ascii.end());
-  // Hangul Jamo (0x1100-0x11FF)
-  auto jamo = generate_codepoint_range(0x1100, 0x11FF);
-  codepoints.insert(codepoints.end(), jamo.begin(), jamo.end());
-  // Hangul Syllables (0xAC00-0xD7AF) - most common Korean characters
-  auto syllables = generate_codepoint_range(0xAC00, 0xD7AF);
-  codepoints.insert(codepoints.end(), syllables.begin(), syllables.end());
-  return codepoints;
-}
+namespace {
 
-// Build codepoints for Japanese: Hiragana + Katakana + common Kanji + ASCII
-static std::vector<int> get_japanese_codepoints() {
-  std::vector<int> codepoints;
-  // ASCII (0x0020-0x007F)
-  auto ascii = generate_codepoint_range(0x0020, 0x007F);
-  codepoints.insert(codepoints.end(), ascii.begin(), ascii.end());
-  // Hiragana (0x3040-0x309F)
-  auto hiragana = generate_codepoint_range(0x3040, 0x309F);
-  codepoints.insert(codepoints.end(), hiragana.begin(), hiragana.end());
-  // Katakana (0x30A0-0x30FF)
-  auto katakana = generate_codepoint_range(0x30A0, 0x30FF);
-  codepoints.insert(codepoints.end(), katakana.begin(), katakana.end());
-  // Common CJK Unified Ideographs subset (0x4E00-0x9FFF) - full range
-  auto kanji = generate_codepoint_range(0x4E00, 0x9FFF);
-  codepoints.insert(codepoints.end(), kanji.begin(), kanji.end());
-  return codepoints;
+// Font files baked at startup, each baked once however many names use it
+enum FontFile {
+  GAEGU,
+  ROUNDED,
+  GARAMOND,
+  SYMBOLS,
+  FREDOKA,
+  BLACKOPS,
+  ATKINSON,
+  FONT_FILE_COUNT
+};
+
+constexpr std::array<const char *, FONT_FILE_COUNT> FONT_FILES = {
+    "Gaegu-Bold.ttf",
+    "eqprorounded-regular.ttf",
+    "EBGaramond-Regular.ttf",
+    "SymbolsNerdFont-Regular.ttf",
+    "Fredoka-VariableFont_wdth,wght.ttf",
+    "BlackOpsOne-Regular.ttf",
+    "AtkinsonHyperlegible-Regular.ttf",
+};
+
+struct NamedFont {
+  const char *name;
+  FontFile file;
+};
+
+// FontManager names in registration order
+const NamedFont NAMED_FONTS[] = {
+    // Default font (used when no language-specific font is set)
+    {ui::UIComponent::DEFAULT_FONT, GAEGU},
+    {ui::UIComponent::SYMBOL_FONT, GAEGU},
+    // English font (ASCII only)
+    {"Gaegu-Bold", GAEGU},
+    // Rounded font for cartoon/tycoon style
+    {"EqProRounded", ROUNDED},
+    // Garamond for elegant/cozy style
+    {"Garamond", GARAMOND},
+    // Symbols/icons font
+    {"NerdSymbols", SYMBOLS},
+    // Fredoka for thick cartoon/bubble style (Tycoon, Angry Birds, Rubber
+    // Bandits)
+    {"Fredoka", FREDOKA},
+    // Black Ops One for military/stencil style (Shooter HUD)
+    {"BlackOpsOne", BLACKOPS},
+    // Atkinson Hyperlegible for accessibility
+    {"Atkinson", ATKINSON},
+};
+
+std::string font_path(const char *file) {
+  return files::get_resource_path("fonts", file).string();
 }
 
-Preload &Preload::make_singleton() {
+void make_singleton() {
   auto &sophie = EntityHelper::createEntity();
   {
     input::add_singleton_components(sophie, get_mapping());
     window_manager::add_singleton_components(sophie, 200);
     ui::add_singleton_components<InputAction>(sophie);
 
-    // Load fonts for all supported languages
-    std::string english_font =
-        files::get_resource_path("fonts", "Gaegu-Bold.ttf").string();
-    std::string korean_font =
-        files::get_resource_path("fonts", "NotoSansMonoCJKkr-Bold.otf")
-            .string();
-    std::string japanese_font =
-        files::get_resource_path("fonts", "Sazanami-Hanazono-Mincho.ttf")
-            .string();
-    // New fonts for game screens
-    std::string rounded_font =
-        files::get_resource_path("fonts", "eqprorounded-regular.ttf").string();
-    std::string garamond_font =
-        files::get_resource_path("fonts", "EBGaramond-Regular.ttf").string();
-    std::string symbols_font =
-        files::get_resource_path("fonts", "SymbolsNerdFont-Regular.ttf")
-            .string();
-    // New fonts for better inspiration matching
-    std::string fredoka_font =
-        files::get_resource_path("fonts", "Fredoka-VariableFont_wdth,wght.ttf")
-            .string();
-    std::string blackops_font =
-        files::get_resource_path("fonts", "BlackOpsOne-Regular.ttf").string();
-    std::string atkinson_font =
-        files::get_resource_path("fonts", "AtkinsonHyperlegible-Regular.ttf")
-            .string();
-
-    // Get codepoints for CJK fonts
-    auto korean_cps = get_korean_codepoints();
-    auto japanese_cps = get_japanese_codepoints();
-
-    sophie
-        .get<ui::FontManager>()
-        // Default font (used when no language-specific font is set)
-        .load_font(ui::UIComponent::DEFAULT_FONT, english_font.c_str())
-        .load_font(ui::UIComponent::SYMBOL_FONT, english_font.c_str())
-        // English font (ASCII only)
-        .load_font("Gaegu-Bold", english_font.c_str())
-        // Rounded font for cartoon/tycoon style
-        .load_font("EqProRounded", rounded_font.c_str())
-        // Garamond for elegant/cozy style
-        .load_font("Garamond", garamond_font.c_str())
-        // Symbols/icons font
-        .load_font("NerdSymbols", symbols_font.c_str())
-        // Fredoka for thick cartoon/bubble style (Tycoon, Angry Birds, Rubber
-        // Bandits)
-        .load_font("Fredoka", fredoka_font.c_str())
-        // Black Ops One for military/stencil style (Shooter HUD)
-        .load_font("BlackOpsOne", blackops_font.c_str())
-        // Atkinson Hyperlegible for accessibility
-        .load_font("Atkinson", atkinson_font.c_str())
-        // Korean font with Hangul codepoints
-        .load_font_with_codepoints("NotoSansKR", korean_font.c_str(),
-                                   korean_cps.data(),
-                                   static_cast<int>(korean_cps.size()))
-        // Japanese font with Hiragana/Katakana/Kanji codepoints
-        .load_font_with_codepoints("Sazanami", japanese_font.c_str(),
-                                   japanese_cps.data(),
-                                   static_cast<int>(japanese_cps.size()));
+    // Names sharing a file share one atlas texture
+    auto &fonts = sophie.get<ui::FontManager>();
+    for (const NamedFont &named : NAMED_FONTS) {
+      std::string path = font_path(FONT_FILES[named.file]);
+      fonts.load_font(named.name, font_registry::load_ui_font(path));
+      font_registry::alias(named.name, font_registry::ui_font_key(path));
+    }
+    // Korean font with Hangul glyphs on demand
+    load_dynamic_font(fonts, "NotoSansKR",
+                      font_path("NotoSansMonoCJKkr-Bold.otf"),
+                      korean_atlas_config());
+    // Japanese font with Kana/Kanji glyphs on demand
+    load_dynamic_font(fonts, "Sazanami",
+                      font_path("Sazanami-Hanazono-Mincho.ttf"),
+                      japanese_atlas_config());
 
     ui::imm::ThemeDefaults::get()
         .set_theme_color(ui::Theme::Usage::Primary, colors::UI_GREEN)
@@ -217,10 +228,96 @@ Preload &Preload::make_singleton() {
         .set_desired_height(afterhours::ui::screen_pct(1.f))
         .enable_font(afterhours::ui::UIComponent::DEFAULT_FONT, 75.f);
   }
+}
+
+} // namespace
+
+Preload &Preload::boot(const StartupOptions &options) {
+  TRACE_ZONE("preload");
+  files::init("Prime Pressure", "resources");
+  // resources.pack, when built, replaces the loose files
+  resource_pack::mount(files::get_resource_path("", "").string());
+
+  // In MCP mode, redirect raylib logs to stderr to keep stdout clean for JSON
+#ifdef AFTER_HOURS_ENABLE_MCP
+  if (g_mcp_mode) {
+    raylib::SetTraceLogCallback(mcp_trace_log_callback);
+  }
+#endif
+
+  // Set log level BEFORE InitWindow to suppress init messages
+  raylib::SetTraceLogLevel(raylib::LOG_ERROR);
+
+  using startup::Affinity;
+  startup::TaskGraph graph;
+
+  // Window size comes from the settings file. Only the parse runs on a
+  // worker, applying it touches the window and audio device.
+  auto settings = graph.add("settings read", Affinity::Worker, [&] {
+    Settings::get().load_save_file(options.width, options.height);
+  });
+  auto window = graph.add(
+      "window", Affinity::Main, [&] { open_window(options); }, {settings});
+  std::vector<startup::TaskGraph::TaskId> settings_deps = {window};
+  if (!options.headless) {
+    // Same thread as CloseAudioDevice in ~Preload
+    settings_deps.push_back(
+        graph.add("audio device", Affinity::Main, [this] { open_audio(); }));
+  }
+  graph.add(
+      "settings apply", Affinity::Main,
+      [] { Settings::get().refresh_settings(); }, settings_deps);
+
+  std::string gamepad_db;
+  auto gamepad_read = graph.add("gamepad db read", Affinity::Worker,
+                                [&] { gamepad_db = read_gamepad_mappings(); });
+  graph.add(
+      "gamepad db apply", Affinity::Main,
+      [&] {
+        if (!gamepad_db.empty()) {
+          input::set_gamepad_mappings(gamepad_db.c_str());
+        }
+      },
+      {window, gamepad_read});
+
+  // Rasterize (or map from the cache) on workers, upload on the main thread
+  std::array<font_cache::BakedFont, FONT_FILE_COUNT> baked;
+  std::vector<startup::TaskGraph::TaskId> uploads;
+  for (size_t file = 0; file < FONT_FILE_COUNT; file++) {
+    auto bake = graph.add(
+        std::string("bake ") + FONT_FILES[file], Affinity::Worker,
+        [&baked, file] {
+          baked[file] = font_cache::bake_ui_font(font_path(FONT_FILES[file]));
+        });
+    uploads.push_back(graph.add(
+        std::string("upload ") + FONT_FILES[file], Affinity::Main,
+        [&baked, file] {
+          font_registry::add(
+              font_registry::ui_font_key(font_path(FONT_FILES[file])),
+              font_cache::upload_ui_font(baked[file]));
+        },
+        {window, bake}));
+  }
+
+  uploads.push_back(window);
+  graph.add(
+      "ui singleton", Affinity::Main, [] { make_singleton(); },
+      uploads);
+
+  graph.run();
+  if (options.print_stats) {
+    graph.print_stats(std::cout);
+    font_registry::print_report(std::cout);
+  }
   return *this;
 }
 
 Preload::~Preload() {
+  // Textures need the GL context, so release them before CloseWindow
+  glyph_atlas::unload_all();
+  gradient_texture::unload_all();
+  post_fx::unload_all();
+  texture_cache::unload_all();
   if (raylib::IsAudioDeviceReady()) {
     raylib::CloseAudioDevice();
   }
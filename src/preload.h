@@ -5,6 +5,17 @@
 #include <afterhours/src/library.h>
 #include <afterhours/src/singleton.h>
 
+struct StartupOptions {
+  const char *title = "UI Tester";
+  // Hidden window, no frame cap and no audio (for CI E2E runs)
+  bool headless = false;
+  // Resolution used when the settings file does not override it
+  int width = 1280;
+  int height = 720;
+  // Print per task timings once startup finishes (--startup-stats)
+  bool print_stats = false;
+};
+
 SINGLETON_FWD(Preload)
 struct Preload {
   SINGLETON(Preload)
@@ -15,6 +26,12 @@ struct Preload {
   Preload(const Preload &) = delete;
   void operator=(const Preload &) = delete;
 
-  Preload &init(const char *title);
-  Preload &make_singleton();
+  // Loads settings, opens the window and audio device, and loads the
+  // gamepad DB and fonts. Independent steps run as a startup::TaskGraph so
+  // font baking and file parsing overlap with window creation.
+  Preload &boot(const StartupOptions &options);
+
+private:
+  void open_window(const StartupOptions &options);
+  void open_audio();
 };
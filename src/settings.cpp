@@ -4,6 +4,7 @@
 #include <memory>
 #include <nlohmann/json.hpp>
 
+#include "engine/post_fx.h"
 #include "rl.h"
 #include <afterhours/src/plugins/files.h>
 
@@ -39,6 +40,8 @@ struct S_Data {
 
   bool fullscreen_enabled = false;
   bool post_processing_enabled = true;
+  // No passes by default, so nothing extra is allocated or drawn
+  std::string post_fx;
 
   std::filesystem::path loaded_from;
 };
@@ -70,6 +73,7 @@ void to_json(nlohmann::json &j, const S_Data &data) {
 
   j["fullscreen_enabled"] = data.fullscreen_enabled;
   j["post_processing_enabled"] = data.post_processing_enabled;
+  j["post_fx"] = data.post_fx;
 }
 
 void from_json(const nlohmann::json &j, S_Data &data) {
@@ -85,6 +89,10 @@ void from_json(const nlohmann::json &j, S_Data &data) {
   if (j.contains("post_processing_enabled")) {
     data.post_processing_enabled = j.at("post_processing_enabled");
   }
+
+  if (j.contains("post_fx")) {
+    data.post_fx = j.at("post_fx");
+  }
 }
 
 Settings::Settings() { data = new S_Data(); }
@@ -128,6 +136,7 @@ void Settings::refresh_settings() {
   update_sfx_volume(data->sfx_volume);
   update_master_volume(data->master_volume);
   match_fullscreen_to_setting(data->fullscreen_enabled);
+  update_post_fx(data->post_fx);
 }
 
 void Settings::toggle_fullscreen() {
@@ -145,6 +154,17 @@ void Settings::toggle_post_processing() {
   data->post_processing_enabled = !data->post_processing_enabled;
 }
 
+const std::string &Settings::get_post_fx() const { return data->post_fx; }
+
+void Settings::update_post_fx(const std::string &list) {
+  std::vector<post_fx::Pass> passes;
+  if (!post_fx::parse(list, passes)) {
+    log_warn("Unknown post_fx pass in '{}', running none", list);
+  }
+  data->post_fx = list;
+  post_fx::set_chain(std::move(passes));
+}
+
 bool Settings::load_save_file(int width, int height) {
   this->data->resolution.width = width;
   this->data->resolution.height = height;
@@ -181,7 +201,6 @@ bool Settings::load_save_file(int width, int height) {
 
     (*this->data) = settingsJSON;
     this->data->loaded_from = settings_places[file_loc];
-    refresh_settings();
     return true;
 
   } catch (const std::exception &e) {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include <afterhours/src/library.h>
 #include <afterhours/src/plugins/window_manager.h>
@@ -20,6 +21,8 @@ struct Settings {
   Settings(const Settings &) = delete;
   void operator=(const Settings &) = delete;
 
+  // Only parses the file, call refresh_settings on the main thread once the
+  // window and audio device exist to apply it
   bool load_save_file(int, int);
   void write_save_file();
 
@@ -44,4 +47,8 @@ struct Settings {
 
   bool &get_post_processing_enabled();
   void toggle_post_processing();
+
+  // Comma-separated post_fx passes run while post processing is enabled
+  const std::string &get_post_fx() const;
+  void update_post_fx(const std::string &);
 };
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "../engine/texture_cache.h"
 #include <afterhours/ah.h>
+#include <afterhours/src/plugins/files.h>
 #include <functional>
 #include <map>
 #include <memory>
@@ -11,14 +13,79 @@
 // Set by ScreenCyclerSystem when switching screens
 inline afterhours::SystemBase *g_current_screen = nullptr;
 
+// Hooks the screen cycler uses to get a neighbouring screen ready before it
+// is shown
+struct ScreenPrewarm {
+  virtual ~ScreenPrewarm() = default;
+  // Files the first frame loads through texture_cache, decoded off-thread
+  virtual std::vector<std::string> texture_paths() const { return {}; }
+  // Does the first frame's loading early, on the main thread
+  virtual void prewarm() {}
+};
+
+// Lets the screen demo stop rendering while a screen is static, see
+// IdleDetector
+struct ScreenActivity {
+  virtual ~ScreenActivity() = default;
+  // Whether the next frame can differ from the last one without any input.
+  // Screens that only change in response to input return false, or true
+  // while they have a change of their own pending.
+  virtual bool needs_redraw() const { return true; }
+};
+
 // Base class for screen systems that only runs when this screen is active
 template <typename... Components>
-struct ScreenSystem : afterhours::System<Components...> {
+struct ScreenSystem : afterhours::System<Components...>,
+                      ScreenPrewarm,
+                      ScreenActivity {
   virtual bool should_run(const float) const override {
     return g_current_screen == this;
   }
 };
 
+// Texture members of Screen and the files they load from, relative to
+// directory under resources/
+template <typename Screen> struct TextureTable {
+  const char *directory;
+  std::vector<std::pair<raylib::Texture2D Screen::*, const char *>> files;
+};
+
+// Screen whose textures are a fixed table of members. Screen only defines
+//   static const TextureTable<Screen> &texture_table();
+// and calls load_textures() before drawing; paths and prewarming follow
+// from the table.
+template <typename Screen, typename... Components>
+struct TexturedScreenSystem : ScreenSystem<Components...> {
+  // Shared with other screens through texture_cache
+  texture_cache::TextureSet textures;
+  bool textures_loaded = false;
+
+  std::vector<std::string> texture_paths() const override {
+    const TextureTable<Screen> &table = Screen::texture_table();
+    std::vector<std::string> paths;
+    for (const auto &entry : table.files) {
+      paths.push_back(
+          afterhours::files::get_resource_path(table.directory, entry.second)
+              .string());
+    }
+    return paths;
+  }
+
+  void load_textures() {
+    if (textures_loaded)
+      return;
+    textures_loaded = true;
+    const TextureTable<Screen> &table = Screen::texture_table();
+    std::vector<std::string> paths = texture_paths();
+    Screen &screen = static_cast<Screen &>(*this);
+    for (size_t i = 0; i < paths.size(); i++) {
+      screen.*table.files[i].first = textures.load(paths[i]);
+    }
+  }
+
+  void prewarm() override { load_textures(); }
+};
+
 struct ExampleScreen {
   std::string name;
   std::string category;
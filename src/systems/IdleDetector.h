@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../engine/frame_stats.h"
+#include "../rl.h"
+#include "ExampleScreenRegistry.h"
+#include <afterhours/ah.h>
+#include <afterhours/src/plugins/modal.h>
+#include <afterhours/src/plugins/toast.h>
+
+// Decides when the screen demo can stop running systems because nothing on
+// screen can change: no input, the screen does not need a redraw, no toast
+// is counting down, no modal opened or closed, no entities appeared or went
+// away, and a short settle period has passed since the last of those so
+// hover, press and modal fade transitions finish. Screens that animate on
+// their own report it through ScreenActivity::needs_redraw().
+// While idle the demo re-presents the last mainRT and sleeps in EndDrawing
+// until the OS delivers an event.
+class IdleDetector {
+public:
+  // Frames keep running this long after the last activity
+  static constexpr float SETTLE_SECONDS = 1.0f;
+
+  explicit IdleDetector(bool enabled) : enabled_(enabled) {}
+
+  // Forces full frames for the settle period, e.g. after a screen switch
+  void wake() { quiet_seconds_ = 0.f; }
+
+  // Once per frame before systems run. dt is the last frame's duration.
+  bool idle(const afterhours::SystemBase *screen, float dt) {
+    if (!enabled_)
+      return false;
+
+    size_t entities = afterhours::EntityHelper::get_entities().size();
+    bool changed = entities != entity_count_;
+    entity_count_ = entities;
+    // Always polled so the open modal count stays current
+    bool overlays = overlay_activity();
+
+    // The perf HUD wants real frames to measure
+    if (changed || overlays || frame_stats::enabled() || input_activity() ||
+        redraw_requested(screen)) {
+      quiet_seconds_ = 0.f;
+    } else {
+      quiet_seconds_ += dt;
+    }
+
+    bool now_idle = quiet_seconds_ >= SETTLE_SECONDS;
+    if (now_idle != waiting_) {
+      waiting_ = now_idle;
+      if (waiting_) {
+        raylib::EnableEventWaiting();
+      } else {
+        raylib::DisableEventWaiting();
+      }
+    }
+    return now_idle;
+  }
+
+private:
+  static bool redraw_requested(const afterhours::SystemBase *screen) {
+    auto *activity = dynamic_cast<const ScreenActivity *>(screen);
+    return !activity || activity->needs_redraw();
+  }
+
+  // Toasts expire and slide out on a timer with no input, so frames keep
+  // running while any is up. A modal changing the open stack restarts the
+  // settle period for its backdrop fade.
+  bool overlay_activity() {
+    if (afterhours::EntityQuery()
+            .whereHasComponent<afterhours::toast::Toast>()
+            .has_values())
+      return true;
+    auto *modals = afterhours::EntityHelper::get_singleton_cmp<
+        afterhours::modal::ModalRoot>();
+    size_t open = modals ? modals->modal_stack.size() : 0;
+    bool changed = open != open_modals_;
+    open_modals_ = open;
+    return changed;
+  }
+
+  static bool input_activity() {
+    raylib::Vector2 delta = raylib::GetMouseDelta();
+    if (delta.x != 0.f || delta.y != 0.f ||
+        raylib::GetMouseWheelMove() != 0.f || raylib::IsWindowResized())
+      return true;
+    for (int button = raylib::MOUSE_BUTTON_LEFT;
+         button <= raylib::MOUSE_BUTTON_MIDDLE; button++) {
+      if (raylib::IsMouseButtonDown(button) ||
+          raylib::IsMouseButtonReleased(button))
+        return true;
+    }
+    // Every desktop key code, KEY_SPACE through KEY_KB_MENU
+    for (int key = raylib::KEY_SPACE; key <= raylib::KEY_KB_MENU; key++) {
+      if (raylib::IsKeyDown(key) || raylib::IsKeyReleased(key))
+        return true;
+    }
+    // Gamepads do not end an event wait; a button held when some other
+    // event arrives still counts
+    if (raylib::IsGamepadAvailable(0)) {
+      for (int button = raylib::GAMEPAD_BUTTON_LEFT_FACE_UP;
+           button <= raylib::GAMEPAD_BUTTON_RIGHT_THUMB; button++) {
+        if (raylib::IsGamepadButtonDown(0, button))
+          return true;
+      }
+    }
+    return false;
+  }
+
+  bool enabled_;
+  bool waiting_ = false;
+  float quiet_seconds_ = 0.f;
+  size_t entity_count_ = 0;
+  size_t open_modals_ = 0;
+};
@@ -1,4 +1,6 @@
+#include "../engine/post_fx.h"
 #include "../game.h"
+#include "../settings.h"
 #include "LetterboxLayout.h"
 
 struct RenderRenderTexture : afterhours::System<> {
@@ -12,9 +14,8 @@ struct RenderRenderTexture : afterhours::System<> {
     const LetterboxLayout layout =
         compute_letterbox_layout(window_w, window_h, content_w, content_h);
 
-    const raylib::Rectangle src{0.0f, 0.0f, (float)mainRT.texture.width,
-                                -(float)mainRT.texture.height};
-    raylib::DrawTexturePro(mainRT.texture, src, layout.dst, {0.0f, 0.0f}, 0.0f,
-                           raylib::WHITE);
+    // A plain blit unless post processing has passes to run
+    post_fx::present(mainRT.texture, layout.dst,
+                     Settings::get().get_post_processing_enabled());
   }
 };
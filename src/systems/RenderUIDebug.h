@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../components.h"
+#include "../engine/frame_stats.h"
 #include "../eq.h"
 #include "../game.h"
 #include "../input_mapping.h"
@@ -9,17 +10,36 @@
 #include "../settings.h"
 #include <afterhours/ah.h>
 #include <afterhours/src/plugins/ui.h>
+#include <algorithm>
+#include <chrono>
 #include <fmt/format.h>
 #include <string>
 
 using namespace afterhours::ui;
 using namespace afterhours::ui::imm;
 
+// UI state, always shown, plus a perf HUD: a frame-time graph with
+// percentiles, entity counts, render commands by kind and per-system times
+// (ENABLE_PERF_HUD=1 builds). ` toggles the HUD, F9 dumps its frame window
+// to a CSV in the working directory.
 struct RenderUIDebug
     : afterhours::System<afterhours::ui::UIContext<InputAction>> {
+  bool perf_visible = false;
+
   virtual void for_each_with(afterhours::Entity &entity,
                              afterhours::ui::UIContext<InputAction> &context,
                              float) override {
+    if (raylib::IsKeyPressed(raylib::KEY_GRAVE)) {
+      perf_visible = !perf_visible;
+      frame_stats::set_enabled(perf_visible);
+    }
+    if (perf_visible) {
+      if (raylib::IsKeyPressed(raylib::KEY_F9)) {
+        dump_csv();
+      }
+      render_perf(context);
+    }
+
     // Always show debug info
     float fontSize = 16.0f;
     float y = 10.0f;
@@ -108,4 +128,116 @@ struct RenderUIDebug
                        raylib::WHITE);
     }
   }
+
+private:
+  static constexpr int PANEL_WIDTH = 320;
+  static constexpr int FONT_SIZE = 14;
+  static constexpr int LINE_HEIGHT = FONT_SIZE + 4;
+  static constexpr int GRAPH_HEIGHT = 60;
+  // Graph scale, two 60 fps frames
+  static constexpr float GRAPH_MAX_MS = 33.3f;
+
+  static void dump_csv() {
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    std::string path = fmt::format("frame_stats_{}.csv", seconds.count());
+    if (frame_stats::write_csv(path)) {
+      log_info("[perf] Wrote {}", path);
+    } else {
+      log_warn("[perf] Failed to write {}", path);
+    }
+  }
+
+  void render_perf(const afterhours::ui::UIContext<InputAction> &context) {
+    int x = Settings::get().get_screen_width() - PANEL_WIDTH - 10;
+    int y = 10;
+    auto line = [&](const std::string &text, raylib::Color color) {
+      raylib::DrawText(text.c_str(), x + 6, y, FONT_SIZE, color);
+      y += LINE_HEIGHT;
+    };
+
+    std::vector<frame_stats::SystemTime> systems =
+        frame_stats::system_times();
+    int rows = 7 + static_cast<int>(std::max<size_t>(systems.size(), 1));
+    raylib::DrawRectangle(x, y, PANEL_WIDTH,
+                          rows * LINE_HEIGHT + GRAPH_HEIGHT + 12,
+                          raylib::Color{0, 0, 0, 190});
+    y += 4;
+
+    frame_stats::Percentiles frames = frame_stats::frame_percentiles();
+    line(fmt::format("frame ms  p50 {:.2f}  p95 {:.2f}  p99 {:.2f}",
+                     frames.p50, frames.p95, frames.p99),
+         raylib::WHITE);
+    line(fmt::format("max {:.2f} ms over {} frames", frames.max,
+                     frame_stats::frame_history().size()),
+         raylib::LIGHTGRAY);
+
+    render_graph(x + 6, y, PANEL_WIDTH - 12);
+    y += GRAPH_HEIGHT + 6;
+
+    size_t ui_count = 0;
+    const auto &entities = afterhours::EntityHelper::get_entities();
+    for (const auto &e : entities) {
+      if (e && e->has<UIComponent>())
+        ui_count++;
+    }
+    line(fmt::format("entities {}  ui components {}", entities.size(),
+                     ui_count),
+         raylib::WHITE);
+
+    // Kind is the component that decides how the command draws
+    size_t text = 0, filled = 0, other = 0;
+    for (const auto &cmd : context.render_cmds) {
+      try {
+        afterhours::Entity &ent =
+            afterhours::EntityHelper::getEntityForIDEnforce(cmd.id);
+        if (ent.has<HasLabel>()) {
+          text++;
+        } else if (ent.has<afterhours::HasColor>()) {
+          filled++;
+        } else {
+          other++;
+        }
+      } catch (...) {
+        other++;
+      }
+    }
+    line(fmt::format("render cmds {}  text {}  fill {}  other {}",
+                     context.render_cmds.size(), text, filled, other),
+         raylib::WHITE);
+
+    line("system              last ms   mean ms", raylib::LIGHTGRAY);
+    if (systems.empty()) {
+      line("build with ENABLE_PERF_HUD=1", raylib::GRAY);
+    }
+    for (const frame_stats::SystemTime &time : systems) {
+      line(fmt::format("{:<20.20}{:>7.3f}{:>10.3f}", time.name, time.last_ms,
+                       time.mean_ms),
+           time.mean_ms > 1.f ? raylib::YELLOW : raylib::WHITE);
+    }
+    line("` hide   F9 dump csv", raylib::GRAY);
+  }
+
+  static void render_graph(int x, int y, int width) {
+    raylib::DrawRectangleLines(x, y, width, GRAPH_HEIGHT, raylib::DARKGRAY);
+    auto height_for = [](float ms) {
+      return static_cast<int>(std::min(ms / GRAPH_MAX_MS, 1.f) *
+                              static_cast<float>(GRAPH_HEIGHT));
+    };
+    // 60 fps budget
+    int budget_y = y + GRAPH_HEIGHT - height_for(16.7f);
+    raylib::DrawLine(x, budget_y, x + width, budget_y, raylib::DARKGREEN);
+
+    std::vector<float> history = frame_stats::frame_history();
+    // Newest frame at the right edge, one pixel per frame
+    size_t shown = std::min(history.size(), static_cast<size_t>(width));
+    for (size_t i = 0; i < shown; i++) {
+      float ms = history[history.size() - shown + i];
+      int bar = height_for(ms);
+      int bar_x = x + width - static_cast<int>(shown) + static_cast<int>(i);
+      raylib::DrawLine(bar_x, y + GRAPH_HEIGHT, bar_x,
+                       y + GRAPH_HEIGHT - bar,
+                       ms > 16.7f ? raylib::ORANGE : raylib::SKYBLUE);
+    }
+  }
 };
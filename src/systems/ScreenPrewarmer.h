@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../engine/texture_cache.h"
+#include "../engine/trace.h"
+#include "ExampleScreenRegistry.h"
+#include <afterhours/ah.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Keeps the screens on either side of the current one constructed, with
+// their textures decoded on workers and uploaded ahead of time, so cycling
+// to one of them is a pointer swap instead of a first-frame load
+class ScreenPrewarmer {
+public:
+  // radius is how many screens on each side stay warm, 0 disables it
+  ScreenPrewarmer(std::vector<std::string> names, int radius)
+      : names_(std::move(names)), radius_(std::max(radius, 0)) {}
+
+  ~ScreenPrewarmer() {
+    for (const Slot &slot : slots_) {
+      texture_cache::drop_prefetched(slot.paths);
+    }
+  }
+
+  ScreenPrewarmer(const ScreenPrewarmer &) = delete;
+  ScreenPrewarmer &operator=(const ScreenPrewarmer &) = delete;
+
+  // The prewarmed screen at index, or a freshly created one
+  std::unique_ptr<afterhours::SystemBase> take(int index) {
+    auto it = std::find_if(slots_.begin(), slots_.end(), [&](const Slot &slot) {
+      return slot.index == index;
+    });
+    if (it != slots_.end()) {
+      std::unique_ptr<afterhours::SystemBase> screen = std::move(it->screen);
+      slots_.erase(it);
+      return screen;
+    }
+    return ExampleScreenRegistry::get().create_screen(names_[index]);
+  }
+
+  // Once per frame: queues decodes for the neighbours of current and
+  // finishes prewarming at most one whose decodes are done, so no single
+  // frame pays for a whole screen
+  void update(int current) {
+    if (radius_ == 0 || names_.size() < 2)
+      return;
+    if (current != current_) {
+      current_ = current;
+      retarget();
+    }
+    for (Slot &slot : slots_) {
+      if (slot.warmed || !texture_cache::prefetched(slot.paths))
+        continue;
+      TRACE_ZONE("prewarm screen");
+      if (auto *hooks = dynamic_cast<ScreenPrewarm *>(slot.screen.get())) {
+        hooks->prewarm();
+      }
+      slot.warmed = true;
+      break;
+    }
+  }
+
+private:
+  struct Slot {
+    int index = 0;
+    std::unique_ptr<afterhours::SystemBase> screen;
+    std::vector<std::string> paths;
+    bool warmed = false;
+  };
+
+  std::vector<int> neighbours() const {
+    const int count = static_cast<int>(names_.size());
+    std::vector<int> wanted;
+    for (int step = 1; step <= radius_; step++) {
+      for (int index : {(current_ + step) % count,
+                        (current_ - step % count + count) % count}) {
+        if (index != current_ &&
+            std::find(wanted.begin(), wanted.end(), index) == wanted.end())
+          wanted.push_back(index);
+      }
+    }
+    return wanted;
+  }
+
+  void retarget() {
+    std::vector<int> wanted = neighbours();
+    std::erase_if(slots_, [&](const Slot &slot) {
+      bool keep = std::find(wanted.begin(), wanted.end(), slot.index) !=
+                  wanted.end();
+      if (!keep)
+        texture_cache::drop_prefetched(slot.paths);
+      return !keep;
+    });
+
+    for (int index : wanted) {
+      bool present =
+          std::any_of(slots_.begin(), slots_.end(),
+                      [&](const Slot &slot) { return slot.index == index; });
+      if (present)
+        continue;
+      Slot slot;
+      slot.index = index;
+      slot.screen = ExampleScreenRegistry::get().create_screen(names_[index]);
+      if (!slot.screen)
+        continue;
+      if (auto *hooks = dynamic_cast<ScreenPrewarm *>(slot.screen.get())) {
+        slot.paths = hooks->texture_paths();
+      }
+      for (const std::string &path : slot.paths) {
+        texture_cache::prefetch(path);
+      }
+      slots_.push_back(std::move(slot));
+    }
+  }
+
+  std::vector<std::string> names_;
+  int radius_;
+  int current_ = -1;
+  std::vector<Slot> slots_;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../engine/debug_name.h"
 #include "../external.h"
 #include <afterhours/ah.h>
 
@@ -40,7 +41,7 @@ struct SetupTabbingTest : afterhours::System<UIContext<InputAction>> {
                          static_cast<unsigned char>(80 + i * 20), 100,
                          static_cast<unsigned char>(150 + i * 20), 255})
                      .with_font(UIComponent::DEFAULT_FONT, 20.0f)
-                     .with_debug_name("tab_button_" + std::to_string(i)));
+                     .with_debug_name(DebugName("tab_button_", i)));
 
       if (button_result) {
         button_clicks[i]++;
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "../engine/frame_stats.h"
+#include "../engine/trace.h"
+#include <afterhours/ah.h>
+#include <memory>
+
+// Systems are wrapped only when something reads the timings: trace zones
+// (ENABLE_TRACE=1) or the perf HUD's system rows (ENABLE_PERF_HUD=1).
+// Otherwise traced() and the group markers compile away.
+#if defined(AFTER_HOURS_ENABLE_TRACE) || defined(AFTER_HOURS_ENABLE_PERF_HUD)
+#define AFTER_HOURS_TIME_SYSTEMS
+#endif
+
+// Forwards to a wrapped system and times each run from once() to after(),
+// as a trace zone when tracing is compiled in and for the perf HUD when
+// frame_stats is enabled
+struct TracedSystem : afterhours::System<> {
+  std::unique_ptr<afterhours::SystemBase> inner;
+  const char *name;
+  frame_stats::Slot slot;
+
+  TracedSystem(std::unique_ptr<afterhours::SystemBase> system,
+               const char *zone_name)
+      : inner(std::move(system)), name(zone_name),
+        slot(frame_stats::slot(zone_name)) {}
+
+  virtual bool should_run(const float dt) const override {
+    return inner->should_run(dt);
+  }
+
+  virtual void once(const float dt) override {
+    TRACE_BEGIN(name);
+    frame_stats::begin(slot);
+    inner->once(dt);
+  }
+
+  virtual void for_each(afterhours::Entity &entity, const float dt) override {
+    inner->for_each(entity, dt);
+  }
+
+  virtual void for_each(const afterhours::Entity &entity,
+                        const float dt) const override {
+    inner->for_each(entity, dt);
+  }
+
+  virtual void for_each_derived(afterhours::Entity &entity,
+                                const float dt) override {
+    inner->for_each_derived(entity, dt);
+  }
+
+  virtual void for_each_derived(const afterhours::Entity &entity,
+                                const float dt) const override {
+    inner->for_each_derived(entity, dt);
+  }
+
+  virtual void after(const float dt) override {
+    inner->after(dt);
+    frame_stats::end(slot);
+    TRACE_END(name);
+  }
+};
+
+// Marks where a group of systems registered by an afterhours helper starts
+// or ends, so the group shows up as one zone or HUD row
+struct TraceMarker : afterhours::System<> {
+  const char *name;
+  bool begins;
+  frame_stats::Slot slot;
+
+  TraceMarker(const char *zone_name, bool is_begin)
+      : name(zone_name), begins(is_begin),
+        slot(frame_stats::slot(zone_name)) {}
+
+  virtual void once(const float) override {
+    if (begins) {
+      TRACE_BEGIN(name);
+      frame_stats::begin(slot);
+    } else {
+      frame_stats::end(slot);
+      TRACE_END(name);
+    }
+  }
+};
+
+// Wraps the system in a TracedSystem when system timing is compiled in,
+// otherwise hands it back untouched
+inline std::unique_ptr<afterhours::SystemBase>
+traced(std::unique_ptr<afterhours::SystemBase> system, const char *name) {
+#ifdef AFTER_HOURS_TIME_SYSTEMS
+  return std::make_unique<TracedSystem>(std::move(system), name);
+#else
+  (void)name;
+  return system;
+#endif
+}
+
+#define TRACED_SYSTEM(Type, ...)                                               \
+  traced(std::make_unique<Type>(__VA_ARGS__), #Type)
+
+// Markers around systems registered by afterhours helpers, which cannot
+// be wrapped one by one
+inline void trace_update_group(afterhours::SystemManager &systems,
+                               const char *name, bool begins) {
+#ifdef AFTER_HOURS_TIME_SYSTEMS
+  systems.register_update_system(std::make_unique<TraceMarker>(name, begins));
+#else
+  (void)systems;
+  (void)name;
+  (void)begins;
+#endif
+}
+
+inline void trace_render_group(afterhours::SystemManager &systems,
+                               const char *name, bool begins) {
+#ifdef AFTER_HOURS_TIME_SYSTEMS
+  systems.register_render_system(std::make_unique<TraceMarker>(name, begins));
+#else
+  (void)systems;
+  (void)name;
+  (void)begins;
+#endif
+}
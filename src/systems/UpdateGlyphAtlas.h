@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../engine/glyph_atlas.h"
+#include <afterhours/ah.h>
+#include <afterhours/src/plugins/ui.h>
+
+// Rasterizes the glyphs this frame's text needs into the dynamic font
+// atlases. Runs at the start of rendering, after every label for the frame
+// exists and before any text is drawn. Labels are requested here; text kept
+// outside a HasLabel (text inputs, direct draws) is requested with
+// glyph_atlas::request_text by whoever owns it, during the update.
+struct UpdateGlyphAtlas : afterhours::System<afterhours::ui::HasLabel> {
+  void for_each_with(afterhours::Entity &, afterhours::ui::HasLabel &label,
+                     float) override {
+    glyph_atlas::request_text(label.label);
+  }
+
+  void after(float) override {
+    // FontManager keeps a copy of the font, refresh it when the atlas
+    // texture grew or new glyphs were added
+    glyph_atlas::flush([](const std::string &name, const raylib::Font &font) {
+      if (auto *fonts = afterhours::EntityHelper::get_singleton_cmp<
+              afterhours::ui::FontManager>()) {
+        fonts->load_font(name, font);
+      }
+    });
+    // Requests from now until the next flush belong to the next frame, so
+    // update-phase requests are not evicted by that frame's labels
+    glyph_atlas::begin_frame();
+  }
+};
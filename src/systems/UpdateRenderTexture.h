@@ -18,8 +18,7 @@ struct UpdateRenderTexture : afterhours::System<> {
       resolution = pcr->current_resolution;
       raylib::UnloadRenderTexture(mainRT);
       mainRT = raylib::LoadRenderTexture(resolution.width, resolution.height);
-      raylib::UnloadRenderTexture(screenRT);
-      screenRT = raylib::LoadRenderTexture(resolution.width, resolution.height);
+      // post_fx resizes screenRT itself, and only allocates it when needed
     }
   }
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/glyph_atlas.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -254,6 +255,8 @@ struct AIMChatDemo : ScreenSystem<UIContext<InputAction>> {
                 .disable_rounded_corners()
                 .with_debug_name("message_input"))) {
     }
+    // The text area draws message_input itself, outside any label
+    glyph_atlas::request_text(message_input);
 
     // Button bar - padding to keep buttons from window edge
     auto button_bar =
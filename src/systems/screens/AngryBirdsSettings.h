@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -166,7 +167,7 @@ struct AngryBirdsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_roundness(1.0f)
                      .with_soft_shadow(3.0f, 5.0f, 10.0f,
                                        afterhours::Color{0, 0, 0, 60})
-                     .with_debug_name("toggle_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("toggle_", i)))) {
         *toggles[i].second = !(*toggles[i].second);
       }
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -119,7 +120,7 @@ struct AutoTextColorShowcase : ScreenSystem<UIContext<InputAction>> {
                  .with_custom_background(dark_colors[i])
                  .with_font(UIComponent::DEFAULT_FONT, 20.0f)
                  .with_margin(Spacing::xs)
-                 .with_debug_name("dark_btn_" + std::to_string(i)));
+                 .with_debug_name(DebugName("dark_btn_", i)));
     }
 
     // Row of light backgrounds
@@ -146,7 +147,7 @@ struct AutoTextColorShowcase : ScreenSystem<UIContext<InputAction>> {
                  .with_custom_background(light_colors[i])
                  .with_font(UIComponent::DEFAULT_FONT, 20.0f)
                  .with_margin(Spacing::xs)
-                 .with_debug_name("light_btn_" + std::to_string(i)));
+                 .with_debug_name(DebugName("light_btn_", i)));
     }
 
     // Section 2: Mid-tone colors (edge cases)
@@ -191,7 +192,7 @@ struct AutoTextColorShowcase : ScreenSystem<UIContext<InputAction>> {
                  .with_custom_background(mid_colors[i])
                  .with_font(UIComponent::DEFAULT_FONT, 20.0f)
                  .with_margin(Spacing::xs)
-                 .with_debug_name("mid_btn_" + std::to_string(i)));
+                 .with_debug_name(DebugName("mid_btn_", i)));
     }
 
     // Section 3: How to disable auto text color
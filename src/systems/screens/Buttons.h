@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -231,7 +232,7 @@ struct ButtonsGallery : ScreenSystem<UIContext<InputAction>> {
                      .with_auto_text_color(true)
                      .with_font(UIComponent::DEFAULT_FONT, 20.0f)
                      .with_rounded_corners(corners)
-                     .with_debug_name("btn_group_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("btn_group_", i)))) {
         click_counts[6 + i]++;
       }
     }
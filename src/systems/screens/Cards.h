@@ -10,6 +10,9 @@ using namespace afterhours::ui;
 using namespace afterhours::ui::imm;
 
 struct CardsGallery : ScreenSystem<UIContext<InputAction>> {
+  // Only changes in response to input
+  bool needs_redraw() const override { return false; }
+
   void for_each_with(afterhours::Entity &entity,
                      UIContext<InputAction> &context, float) override {
     // Apply cozy kraft theme
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -213,7 +214,7 @@ struct CasualSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                  .with_roundness(0.5f)
                  .with_soft_shadow(2.0f, 4.0f, 10.0f,
                                    afterhours::Color{0, 0, 0, 45})
-                 .with_debug_name("left_btn_" + std::to_string(i)));
+                 .with_debug_name(DebugName("left_btn_", i)));
     }
 
     // Right column
@@ -234,7 +235,7 @@ struct CasualSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                  .with_roundness(0.5f)
                  .with_soft_shadow(2.0f, 4.0f, 10.0f,
                                    afterhours::Color{0, 0, 0, 45})
-                 .with_debug_name("right_btn_" + std::to_string(i)));
+                 .with_debug_name(DebugName("right_btn_", i)));
     }
 
     // ========== VERSION INFO ==========
@@ -1,17 +1,18 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
 #include "../../ui_workarounds/NotificationBadge.h"
 #include "../ExampleScreenRegistry.h"
 #include <afterhours/ah.h>
-#include <afterhours/src/plugins/files.h>
 
 using namespace afterhours::ui;
 using namespace afterhours::ui::imm;
 
-struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
+struct CozyCafeScreen
+    : TexturedScreenSystem<CozyCafeScreen, UIContext<InputAction>> {
   // Game state
   float music_volume = 0.7f;
   size_t selected_special = 0;
@@ -19,7 +20,6 @@ struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
   int customers_today = 23;
 
   // Loaded textures
-  bool textures_loaded = false;
   raylib::Texture2D star_filled_tex{};
   raylib::Texture2D star_empty_tex{};
   raylib::Texture2D clock_tex{};
@@ -30,30 +30,21 @@ struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
   raylib::Texture2D icon_research_tex{};
   raylib::Texture2D icon_crafting_tex{};
 
-  void load_textures_if_needed() {
-    if (textures_loaded)
-      return;
-    textures_loaded = true;
-
-    std::string images_path =
-        afterhours::files::get_resource_path("images", "").string();
-    star_filled_tex =
-        raylib::LoadTexture((images_path + "star_filled.png").c_str());
-    star_empty_tex =
-        raylib::LoadTexture((images_path + "star_empty.png").c_str());
-    clock_tex = raylib::LoadTexture((images_path + "clock_icon.png").c_str());
-    flower_tex =
-        raylib::LoadTexture((images_path + "flower_blossom.png").c_str());
-    avatar_guildmate_tex =
-        raylib::LoadTexture((images_path + "avatar_guildmate.png").c_str());
-    avatar_devteam_tex =
-        raylib::LoadTexture((images_path + "avatar_devteam.png").c_str());
-    icon_inventory_tex =
-        raylib::LoadTexture((images_path + "icon_inventory.png").c_str());
-    icon_research_tex =
-        raylib::LoadTexture((images_path + "icon_research.png").c_str());
-    icon_crafting_tex =
-        raylib::LoadTexture((images_path + "icon_crafting.png").c_str());
+  static const TextureTable<CozyCafeScreen> &texture_table() {
+    static const TextureTable<CozyCafeScreen> table = {
+        "images",
+        {
+            {&CozyCafeScreen::star_filled_tex, "star_filled.png"},
+            {&CozyCafeScreen::star_empty_tex, "star_empty.png"},
+            {&CozyCafeScreen::clock_tex, "clock_icon.png"},
+            {&CozyCafeScreen::flower_tex, "flower_blossom.png"},
+            {&CozyCafeScreen::avatar_guildmate_tex, "avatar_guildmate.png"},
+            {&CozyCafeScreen::avatar_devteam_tex, "avatar_devteam.png"},
+            {&CozyCafeScreen::icon_inventory_tex, "icon_inventory.png"},
+            {&CozyCafeScreen::icon_research_tex, "icon_research.png"},
+            {&CozyCafeScreen::icon_crafting_tex, "icon_crafting.png"},
+        }};
+    return table;
   }
 
   std::vector<std::string> daily_specials = {"Lavender Latte", "Honey Toast",
@@ -87,7 +78,7 @@ struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
 
   void for_each_with(afterhours::Entity &entity,
                      UIContext<InputAction> &context, float) override {
-    load_textures_if_needed();
+    load_textures();
 
     Theme theme;
     theme.font = dark_text;
@@ -199,7 +190,7 @@ struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
               .with_custom_background(is_filled ? star_gold : star_empty_color)
               .with_rounded_corners(std::bitset<4>(0b1111))
               .with_roundness(0.3f)
-              .with_debug_name("star_" + std::to_string(i)));
+              .with_debug_name(DebugName("star_", i)));
     }
 
     div(context, mk(entity, 32),
@@ -274,7 +265,7 @@ struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_rounded_corners(std::bitset<4>(0b1111))
                      .with_roundness(0.5f)
                      .with_alignment(TextAlignment::Center)
-                     .with_debug_name("special_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("special_", i)))) {
         selected_special = i;
       }
     }
@@ -358,7 +349,7 @@ struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(right_panel_x + 20.0f, row_y)
               .with_font("Gaegu-Bold", 22.0f)
               .with_custom_text_color(dark_text)
-              .with_debug_name("cust_" + std::to_string(i)));
+              .with_debug_name(DebugName("cust_", i)));
 
       // Progress bar bg
       div(context, mk(entity, 211 + static_cast<int>(i) * 10),
@@ -369,7 +360,7 @@ struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
               .with_custom_background(brown_header)
               .with_rounded_corners(std::bitset<4>(0b1111))
               .with_roundness(0.4f)
-              .with_debug_name("prog_bg_" + std::to_string(i)));
+              .with_debug_name(DebugName("prog_bg_", i)));
 
       // Progress fill
       if (c.progress > 0.0f) {
@@ -382,7 +373,7 @@ struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_custom_background(afterhours::Color{175, 200, 165, 255})
                 .with_rounded_corners(std::bitset<4>(0b1111))
                 .with_roundness(0.4f)
-                .with_debug_name("prog_fill_" + std::to_string(i)));
+                .with_debug_name(DebugName("prog_fill_", i)));
       }
 
       // Time badge
@@ -399,7 +390,7 @@ struct CozyCafeScreen : ScreenSystem<UIContext<InputAction>> {
               .with_rounded_corners(std::bitset<4>(0b1111))
               .with_roundness(0.4f)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("time_" + std::to_string(i)));
+              .with_debug_name(DebugName("time_", i)));
     }
 
     // Serve Next button
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -82,7 +83,7 @@ struct DeadSpaceSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_translate((float)screen_w - 120.0f + (float)i * 4.0f,
                                 0.0f)
                 .with_custom_background(afterhours::Color{15, 20, 22, 180})
-                .with_debug_name("scanline_" + std::to_string(i)));
+                .with_debug_name(DebugName("scanline_", i)));
       }
     }
 
@@ -130,7 +131,7 @@ struct DeadSpaceSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_translate(sidebar_x, item_y)
                      .with_font("EqProRounded", 19.0f)
                      .with_custom_text_color(item_color)
-                     .with_debug_name("initial_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("initial_", i)))) {
         selected_initial = i;
       }
     }
@@ -186,7 +187,7 @@ struct DeadSpaceSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(panel_x + 10.0f, item_y)
               .with_custom_background(item_bg)
               .with_border(panel_border, 1.0f)
-              .with_debug_name("item_bg_" + std::to_string(i)));
+              .with_debug_name(DebugName("item_bg_", i)));
 
       // Highlight bar on selected
       if (is_selected) {
@@ -197,7 +198,7 @@ struct DeadSpaceSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_absolute_position()
                 .with_translate(panel_x + 11.0f, item_y + item_h - 8.0f)
                 .with_custom_background(teal_highlight)
-                .with_debug_name("highlight_" + std::to_string(i)));
+                .with_debug_name(DebugName("highlight_", i)));
       }
 
       // Item text
@@ -213,7 +214,7 @@ struct DeadSpaceSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_translate(panel_x + 25.0f, item_y + 8.0f)
                      .with_font("EqProRounded", 19.0f)
                      .with_custom_text_color(text_color)
-                     .with_debug_name("setting_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("setting_", i)))) {
         selected_main = i;
       }
     }
@@ -1,13 +1,18 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
+#include "../../engine/sprite_atlas.h"
+#include "../../engine/texture_cache.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
+#include "../../ui_workarounds/AtlasSprite.h"
 #include "../../ui_workarounds/GradientBackground.h"
 #include "../../ui_workarounds/NotificationBadge.h"
 #include "../ExampleScreenRegistry.h"
 #include <afterhours/ah.h>
 #include <afterhours/src/plugins/files.h>
+#include <array>
 
 using namespace afterhours::ui;
 using namespace afterhours::ui::imm;
@@ -16,56 +21,33 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
   int64_t cash = 1250980;
   size_t selected_tab = 0; // Navigation tab selection
 
-  // Loaded textures
-  bool textures_loaded = false;
-  raylib::Texture2D coin_tex{};
-  raylib::Texture2D diamond_tex{};
-  raylib::Texture2D star_trophy_tex{};
-  raylib::Texture2D sparkle_tex{};
-  raylib::Texture2D icon_happiness_tex{};
-  raylib::Texture2D icon_resources_tex{};
-  raylib::Texture2D icon_rides_tex{};
-  raylib::Texture2D icon_food_tex{};
-  raylib::Texture2D icon_upgrades_tex{};
-  raylib::Texture2D icon_finance_tex{};
-  raylib::Texture2D icon_shop_tex{};
-  raylib::Texture2D icon_settings_tex{};
-  raylib::Texture2D mascot_tex{};
-  raylib::Texture2D cloud_tex{};
-
-  void load_textures_if_needed() {
-    if (textures_loaded)
-      return;
-    textures_loaded = true;
-
-    std::string images_path =
-        afterhours::files::get_resource_path("images", "").string();
-    coin_tex =
-        raylib::LoadTexture((images_path + "icon_coin_small.png").c_str());
-    diamond_tex =
-        raylib::LoadTexture((images_path + "icon_diamond.png").c_str());
-    star_trophy_tex =
-        raylib::LoadTexture((images_path + "icon_star_trophy.png").c_str());
-    sparkle_tex = raylib::LoadTexture((images_path + "sparkle.png").c_str());
-    icon_happiness_tex =
-        raylib::LoadTexture((images_path + "icon_happiness.png").c_str());
-    icon_resources_tex =
-        raylib::LoadTexture((images_path + "icon_resources.png").c_str());
-    icon_rides_tex =
-        raylib::LoadTexture((images_path + "icon_rides.png").c_str());
-    icon_food_tex =
-        raylib::LoadTexture((images_path + "icon_food.png").c_str());
-    icon_upgrades_tex =
-        raylib::LoadTexture((images_path + "icon_upgrades.png").c_str());
-    icon_finance_tex =
-        raylib::LoadTexture((images_path + "icon_finance.png").c_str());
-    icon_shop_tex =
-        raylib::LoadTexture((images_path + "icon_shop.png").c_str());
-    icon_settings_tex =
-        raylib::LoadTexture((images_path + "icon_settings.png").c_str());
-    mascot_tex =
-        raylib::LoadTexture((images_path + "mascot_business.png").c_str());
-    cloud_tex = raylib::LoadTexture((images_path + "cloud_white.png").c_str());
+  // Shared with other screens through texture_cache, holds the atlas pages
+  texture_cache::TextureSet textures;
+
+  // Sprites drawn with ui_workarounds::atlas_sprite, packed into the atlas
+  // by `make atlas`
+  static constexpr const char *COIN = "images/icon_coin_small.png";
+  static constexpr const char *STAR_TROPHY = "images/icon_star_trophy.png";
+  static constexpr const char *HAPPINESS = "images/icon_happiness.png";
+  static constexpr const char *RESOURCES = "images/icon_resources.png";
+  static constexpr const char *RIDES = "images/icon_rides.png";
+  static constexpr const char *FOOD = "images/icon_food.png";
+  static constexpr const char *UPGRADES = "images/icon_upgrades.png";
+  static constexpr const char *FINANCE = "images/icon_finance.png";
+  static constexpr const char *SHOP = "images/icon_shop.png";
+  static constexpr const char *SETTINGS = "images/icon_settings.png";
+  static constexpr const char *CLOUD = "images/cloud_white.png";
+  static constexpr std::array<const char *, 11> SPRITES = {
+      COIN,     STAR_TROPHY, HAPPINESS, RESOURCES, RIDES, FOOD,
+      UPGRADES, FINANCE,     SHOP,      SETTINGS,  CLOUD};
+
+  std::vector<std::string> texture_paths() const override {
+    return sprite_atlas::files_for(SPRITES);
+  }
+
+  void prewarm() override {
+    for (const char *key : SPRITES)
+      sprite_atlas::load(textures, key);
   }
   float happiness_pct = 0.85f;
   float resources_pct = 0.60f;
@@ -130,8 +112,6 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
 
   void for_each_with(afterhours::Entity &entity,
                      UIContext<InputAction> &context, float) override {
-    load_textures_if_needed();
-
     Theme theme;
     theme.font = dark_text;
     theme.darkfont = dark_text;
@@ -152,7 +132,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
     // ========== BACKGROUND: Sky gradient with lavender at bottom ==========
     ui_workarounds::vertical_gradient(
         context, entity, 1, 0, 0, static_cast<float>(screen_w),
-        static_cast<float>(screen_h) * 0.7f, sky_top, sky_bottom, 10);
+        static_cast<float>(screen_h) * 0.7f, sky_top, sky_bottom);
 
     // Lavender/purple bottom section
     div(context, mk(entity, 5),
@@ -165,24 +145,22 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
             .with_debug_name("lavender_bg"));
 
     // Decorative clouds
-    if (cloud_tex.id != 0) {
-      afterhours::texture_manager::Rectangle src{0, 0, (float)cloud_tex.width,
-                                                 (float)cloud_tex.height};
-      sprite(context, mk(entity, 6), cloud_tex, src,
-             ComponentConfig{}
-                 .with_size(ComponentSize{pixels(80), pixels(40)})
-                 .with_absolute_position()
-                 .with_translate((float)screen_w - 130.0f, 15.0f)
-                 .with_opacity(0.6f)
-                 .with_debug_name("cloud1"));
-      sprite(context, mk(entity, 7), cloud_tex, src,
-             ComponentConfig{}
-                 .with_size(ComponentSize{pixels(60), pixels(30)})
-                 .with_absolute_position()
-                 .with_translate((float)screen_w - 200.0f, 55.0f)
-                 .with_opacity(0.4f)
-                 .with_debug_name("cloud2"));
-    }
+    ui_workarounds::atlas_sprite(
+        context, entity, 6, textures, CLOUD,
+        ComponentConfig{}
+            .with_size(ComponentSize{pixels(80), pixels(40)})
+            .with_absolute_position()
+            .with_translate((float)screen_w - 130.0f, 15.0f)
+            .with_opacity(0.6f)
+            .with_debug_name("cloud1"));
+    ui_workarounds::atlas_sprite(
+        context, entity, 7, textures, CLOUD,
+        ComponentConfig{}
+            .with_size(ComponentSize{pixels(60), pixels(30)})
+            .with_absolute_position()
+            .with_translate((float)screen_w - 200.0f, 55.0f)
+            .with_opacity(0.4f)
+            .with_debug_name("cloud2"));
 
     // ========== TITLE: DREAM INCORPORATED (large puffy 3D text) ==========
     // Using native with_text_stroke() API for efficient outline rendering
@@ -257,16 +235,13 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
             .with_debug_name("currency_pill"));
 
     // Gold coin
-    if (coin_tex.id != 0) {
-      afterhours::texture_manager::Rectangle src{0, 0, (float)coin_tex.width,
-                                                 (float)coin_tex.height};
-      sprite(context, mk(entity, 56), coin_tex, src,
-             ComponentConfig{}
-                 .with_size(ComponentSize{pixels(36), pixels(36)})
-                 .with_absolute_position()
-                 .with_translate(cur_x + 12.0f, 26.0f)
-                 .with_debug_name("coin"));
-    } else {
+    if (!ui_workarounds::atlas_sprite(
+            context, entity, 56, textures, COIN,
+            ComponentConfig{}
+                .with_size(ComponentSize{pixels(36), pixels(36)})
+                .with_absolute_position()
+                .with_translate(cur_x + 12.0f, 26.0f)
+                .with_debug_name("coin"))) {
       div(context, mk(entity, 56),
           ComponentConfig{}
               .with_label("*")
@@ -310,17 +285,13 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
             .with_debug_name("happy_bg"));
-    if (icon_happiness_tex.id != 0) {
-      afterhours::texture_manager::Rectangle src{
-          0, 0, (float)icon_happiness_tex.width,
-          (float)icon_happiness_tex.height};
-      sprite(context, mk(entity, 61), icon_happiness_tex, src,
-             ComponentConfig{}
-                 .with_size(ComponentSize{pixels(44), pixels(44)})
-                 .with_absolute_position()
-                 .with_translate((float)screen_w - 203.0f, stat_y + 7.0f)
-                 .with_debug_name("happy_icon"));
-    }
+    ui_workarounds::atlas_sprite(
+        context, entity, 61, textures, HAPPINESS,
+        ComponentConfig{}
+            .with_size(ComponentSize{pixels(44), pixels(44)})
+            .with_absolute_position()
+            .with_translate((float)screen_w - 203.0f, stat_y + 7.0f)
+            .with_debug_name("happy_icon"));
 
     // Resource gauge icon - larger and more prominent
     div(context, mk(entity, 62),
@@ -335,17 +306,13 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
             .with_debug_name("gauge_bg"));
-    if (icon_resources_tex.id != 0) {
-      afterhours::texture_manager::Rectangle src{
-          0, 0, (float)icon_resources_tex.width,
-          (float)icon_resources_tex.height};
-      sprite(context, mk(entity, 63), icon_resources_tex, src,
-             ComponentConfig{}
-                 .with_size(ComponentSize{pixels(44), pixels(44)})
-                 .with_absolute_position()
-                 .with_translate((float)screen_w - 78.0f, stat_y + 7.0f)
-                 .with_debug_name("resource_icon"));
-    }
+    ui_workarounds::atlas_sprite(
+        context, entity, 63, textures, RESOURCES,
+        ComponentConfig{}
+            .with_size(ComponentSize{pixels(44), pixels(44)})
+            .with_absolute_position()
+            .with_translate((float)screen_w - 78.0f, stat_y + 7.0f)
+            .with_debug_name("resource_icon"));
 
     // ========== METERS ==========
     // IDs 80-95 for meters
@@ -450,14 +417,14 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
     float content_width = 850.0f;
     float content_margin = ((float)screen_w - content_width) / 2.0f;
 
-    std::vector<std::tuple<raylib::Texture2D *, std::string, std::string,
-                           afterhours::Color>>
+    std::vector<
+        std::tuple<const char *, std::string, std::string, afterhours::Color>>
         tabs = {
-            {&icon_rides_tex, "[R]", "Rides", tab_blue},
-            {&icon_food_tex, "[F]", "Food Stalls", tab_green},
-            {&icon_upgrades_tex, "[!]", "Upgrades", tab_pink},
-            {&icon_upgrades_tex, "[X]", "Upgrades", tab_purple},
-            {&icon_finance_tex, "[$]", "Finance", tab_cream},
+            {RIDES, "[R]", "Rides", tab_blue},
+            {FOOD, "[F]", "Food Stalls", tab_green},
+            {UPGRADES, "[!]", "Upgrades", tab_pink},
+            {UPGRADES, "[X]", "Upgrades", tab_purple},
+            {FINANCE, "[$]", "Finance", tab_cream},
         };
 
     float nav_x = content_margin - 10.0f; // Slightly left of content area
@@ -467,7 +434,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
     float tab_spacing = 85.0f;
     for (size_t i = 0; i < tabs.size(); i++) {
       float tab_y = nav_y + (float)i * tab_spacing;
-      auto &[tex_ptr, fallback, label, bg_color] = tabs[i];
+      auto &[icon, fallback, label, bg_color] = tabs[i];
 
       // Tab button background - larger with thicker border
       bool tab_selected = (i == selected_tab);
@@ -490,22 +457,19 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_roundness(0.25f)
                      .with_soft_shadow(3.0f, 5.0f, 12.0f,
                                        afterhours::Color{0, 0, 0, 50})
-                     .with_debug_name("tab_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("tab_", i)))) {
         selected_tab = i;
       }
 
       // Icon image or fallback text - larger
-      if (tex_ptr && tex_ptr->id != 0) {
-        afterhours::texture_manager::Rectangle src{0, 0, (float)tex_ptr->width,
-                                                   (float)tex_ptr->height};
-        sprite(
-            context, mk(entity, 110 + static_cast<int>(i)), *tex_ptr, src,
-            ComponentConfig{}
-                .with_size(ComponentSize{pixels(44), pixels(44)})
-                .with_absolute_position()
-                .with_translate(nav_x + tab_width / 2.0f - 22.0f, tab_y + 6.0f)
-                .with_debug_name("tab_icon_" + std::to_string(i)));
-      } else {
+      if (!ui_workarounds::atlas_sprite(
+              context, entity, 110 + static_cast<int>(i), textures, icon,
+              ComponentConfig{}
+                  .with_size(ComponentSize{pixels(44), pixels(44)})
+                  .with_absolute_position()
+                  .with_translate(nav_x + tab_width / 2.0f - 22.0f,
+                                  tab_y + 6.0f)
+                  .with_debug_name(DebugName("tab_icon_", i)))) {
         div(context, mk(entity, 110 + static_cast<int>(i)),
             ComponentConfig{}
                 .with_label(fallback)
@@ -515,7 +479,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_font("EqProRounded", 22.0f)
                 .with_custom_text_color(dark_text)
                 .with_alignment(TextAlignment::Center)
-                .with_debug_name("tab_icon_fallback_" + std::to_string(i)));
+                .with_debug_name(DebugName("tab_icon_fallback_", i)));
       }
 
       // Tab label - positioned below icon
@@ -529,7 +493,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font("EqProRounded", 13.0f)
               .with_custom_text_color(dark_text)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("tab_label_" + std::to_string(i)));
+              .with_debug_name(DebugName("tab_label_", i)));
 
       // Notification badge on "Upgrades" tab
       if (i == 2) {
@@ -594,7 +558,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(panel_x + 50.0f, item_y)
               .with_font("EqProRounded", 17.0f)
               .with_custom_text_color(dark_text)
-              .with_debug_name("prod_" + std::to_string(i)));
+              .with_debug_name(DebugName("prod_", i)));
 
       // Up arrow
       div(context, mk(entity, 230 + static_cast<int>(i)),
@@ -606,7 +570,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font("EqProRounded", 22.0f)
               .with_custom_text_color(happy_green)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("prod_arrow_" + std::to_string(i)));
+              .with_debug_name(DebugName("prod_arrow_", i)));
     }
 
     // Current Projects section
@@ -650,7 +614,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(panel_x + 355.0f, item_y)
               .with_font("EqProRounded", 15.0f)
               .with_custom_text_color(dark_text)
-              .with_debug_name("proj_" + std::to_string(i)));
+              .with_debug_name(DebugName("proj_", i)));
 
       div(context, mk(entity, 270 + static_cast<int>(i)),
           ComponentConfig{}
@@ -661,7 +625,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font("EqProRounded", 22.0f)
               .with_custom_text_color(happy_green)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("proj_arrow_" + std::to_string(i)));
+              .with_debug_name(DebugName("proj_arrow_", i)));
     }
 
     // ========== ACTION BUTTONS ==========
@@ -689,7 +653,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
               .with_roundness(0.3f)
               .with_soft_shadow(3.0f, 5.0f, 12.0f,
                                 afterhours::Color{0, 0, 0, 60})
-              .with_debug_name("btn_" + std::to_string(i)));
+              .with_debug_name(DebugName("btn_", i)));
     }
 
     // ========== BOTTOM: Chat ==========
@@ -765,10 +729,10 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
             .with_debug_name("milestone_fill"));
 
     // ========== BOTTOM RIGHT: Icons ==========
-    std::vector<std::tuple<raylib::Texture2D *, std::string, std::string>>
-        icon_data = {{&icon_shop_tex, "$", "Shop"},
-                     {&icon_settings_tex, "@", "Settings"},
-                     {&star_trophy_tex, "#", "Leaderboards"}};
+    std::vector<std::tuple<const char *, std::string, std::string>> icon_data =
+        {{SHOP, "$", "Shop"},
+         {SETTINGS, "@", "Settings"},
+         {STAR_TROPHY, "#", "Leaderboards"}};
     float icon_x = (float)screen_w - 270.0f;
     float icon_size = 52.0f;
     float icon_img_size = 32.0f;
@@ -776,7 +740,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
 
     for (size_t i = 0; i < icon_data.size(); i++) {
       float ix = icon_x + (float)i * 82.0f;
-      auto &[tex_ptr, fallback, label] = icon_data[i];
+      auto &[icon, fallback, label] = icon_data[i];
 
       // Button background
       button(context, mk(entity, 500 + static_cast<int>(i)),
@@ -788,21 +752,18 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
                  .with_border(btn_yellow_dark, 2.0f)
                  .with_rounded_corners(std::bitset<4>(0b1111))
                  .with_roundness(1.0f)
-                 .with_debug_name("icon_btn_" + std::to_string(i)));
+                 .with_debug_name(DebugName("icon_btn_", i)));
 
       // Icon image or fallback text
-      if (tex_ptr && tex_ptr->id != 0) {
-        afterhours::texture_manager::Rectangle src{0, 0, (float)tex_ptr->width,
-                                                   (float)tex_ptr->height};
-        sprite(context, mk(entity, 520 + static_cast<int>(i)), *tex_ptr, src,
-               ComponentConfig{}
-                   .with_size(ComponentSize{pixels(icon_img_size),
-                                            pixels(icon_img_size)})
-                   .with_absolute_position()
-                   .with_translate(ix + icon_offset,
-                                   (float)screen_h - 92.0f + icon_offset)
-                   .with_debug_name("icon_img_" + std::to_string(i)));
-      } else {
+      if (!ui_workarounds::atlas_sprite(
+              context, entity, 520 + static_cast<int>(i), textures, icon,
+              ComponentConfig{}
+                  .with_size(ComponentSize{pixels(icon_img_size),
+                                           pixels(icon_img_size)})
+                  .with_absolute_position()
+                  .with_translate(ix + icon_offset,
+                                  (float)screen_h - 92.0f + icon_offset)
+                  .with_debug_name(DebugName("icon_img_", i)))) {
         div(context, mk(entity, 520 + static_cast<int>(i)),
             ComponentConfig{}
                 .with_label(fallback)
@@ -812,7 +773,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_font("EqProRounded", 26.0f)
                 .with_custom_text_color(dark_text)
                 .with_alignment(TextAlignment::Center)
-                .with_debug_name("icon_fallback_" + std::to_string(i)));
+                .with_debug_name(DebugName("icon_fallback_", i)));
       }
 
       // Label below icon
@@ -825,7 +786,7 @@ struct EmpireTycoonScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font("EqProRounded", 12.0f)
               .with_custom_text_color(dark_text)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("icon_label_" + std::to_string(i)));
+              .with_debug_name(DebugName("icon_label_", i)));
     }
   }
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -264,7 +265,7 @@ struct ExampleAccessibility : ScreenSystem<UIContext<InputAction>> {
                  .with_auto_text_color(true)
                  .with_font(UIComponent::DEFAULT_FONT, 16.0f)
                  .with_rounded_corners(std::bitset<4>(0b1111))
-                 .with_debug_name("color_" + std::to_string(i)));
+                 .with_debug_name(DebugName("color_", i)));
     }
 
     // Dark showcase row
@@ -291,7 +292,7 @@ struct ExampleAccessibility : ScreenSystem<UIContext<InputAction>> {
                  .with_auto_text_color(true)
                  .with_font(UIComponent::DEFAULT_FONT, 16.0f)
                  .with_rounded_corners(std::bitset<4>(0b1111))
-                 .with_debug_name("dark_" + std::to_string(i)));
+                 .with_debug_name(DebugName("dark_", i)));
     }
 
     // Footer info
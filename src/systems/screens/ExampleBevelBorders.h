@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -92,7 +93,7 @@ struct ExampleBevelBordersScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font(UIComponent::DEFAULT_FONT, 14.0f)
               .with_custom_text_color(text)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("col_label_" + std::to_string(c)));
+              .with_debug_name(DebugName("col_label_", c)));
     }
 
     for (int r = 0; r < 2; ++r) {
@@ -105,7 +106,7 @@ struct ExampleBevelBordersScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font(UIComponent::DEFAULT_FONT, 16.0f)
               .with_custom_text_color(text)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("row_label_" + std::to_string(r)));
+              .with_debug_name(DebugName("row_label_", r)));
 
       for (int c = 0; c < 4; ++c) {
         float x = start_x + c * (cell + gap);
@@ -126,8 +127,7 @@ struct ExampleBevelBordersScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_font(UIComponent::DEFAULT_FONT, 14.0f)
                 .with_custom_text_color(label_color)
                 .with_alignment(TextAlignment::Center)
-                .with_debug_name("bevel_" + std::to_string(r) + "_" +
-                                 std::to_string(c)));
+                .with_debug_name(DebugName("bevel_", r, c)));
       }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -55,7 +56,7 @@ struct ExampleBordersScreen : ScreenSystem<UIContext<InputAction>> {
               .with_absolute_position()
               .with_translate((float)(i * 65 + 30), 0)
               .with_custom_background(grid_line)
-              .with_debug_name("vgrid_" + std::to_string(i)));
+              .with_debug_name(DebugName("vgrid_", i)));
     }
     for (int i = 0; i < 12; i++) {
       // Horizontal lines
@@ -65,7 +66,7 @@ struct ExampleBordersScreen : ScreenSystem<UIContext<InputAction>> {
               .with_absolute_position()
               .with_translate(0, (float)(i * 55 + 40))
               .with_custom_background(grid_line)
-              .with_debug_name("hgrid_" + std::to_string(i)));
+              .with_debug_name(DebugName("hgrid_", i)));
     }
 
     float start_x = 45.0f;
@@ -121,7 +122,7 @@ struct ExampleBordersScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font(UIComponent::DEFAULT_FONT, 15.0f)
               .with_custom_text_color(bg_deep)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("border_" + std::to_string(i)));
+              .with_debug_name(DebugName("border_", i)));
     }
 
     // Row label
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -10,6 +11,9 @@ using namespace afterhours::ui;
 using namespace afterhours::ui::imm;
 
 struct ExampleColors : ScreenSystem<UIContext<InputAction>> {
+  // Only changes in response to input
+  bool needs_redraw() const override { return false; }
+
   void for_each_with(afterhours::Entity &entity,
                      UIContext<InputAction> &context, float) override {
     // Apply midnight theme for this screen
@@ -132,7 +136,7 @@ struct ExampleColors : ScreenSystem<UIContext<InputAction>> {
               .with_custom_background(custom_colors[i])
               .with_font(UIComponent::DEFAULT_FONT, 20.0f)
               .with_margin(Spacing::xs)
-              .with_debug_name("custom_" + std::to_string(i)));
+              .with_debug_name(DebugName("custom_", i)));
     }
 
     // Info text
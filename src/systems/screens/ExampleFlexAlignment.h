@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -32,6 +33,7 @@ struct ExampleFlexAlignment : ScreenSystem<UIContext<InputAction>> {
             .with_debug_name(label));
 
     // 3 boxes - tall enough to show spacing clearly
+    const std::string item_prefix = label + "_";
     for (int i = 0; i < 3; i++) {
       div(context, mk(container.ent(), i),
           ComponentConfig{}
@@ -41,7 +43,7 @@ struct ExampleFlexAlignment : ScreenSystem<UIContext<InputAction>> {
               .with_auto_text_color(true)
               .with_font(UIComponent::DEFAULT_FONT, 18.0f)
               .with_flex_direction(FlexDirection::Row)
-              .with_debug_name(label + "_" + std::to_string(i)));
+              .with_debug_name(DebugName(item_prefix.c_str(), i)));
     }
   }
 
@@ -88,6 +90,7 @@ struct ExampleFlexAlignment : ScreenSystem<UIContext<InputAction>> {
             .with_debug_name(label + "_inner"));
 
     // Three boxes
+    const std::string item_prefix = label + "_";
     for (int i = 0; i < 3; i++) {
       div(context, mk(inner.ent(), i),
           ComponentConfig{}
@@ -97,7 +100,7 @@ struct ExampleFlexAlignment : ScreenSystem<UIContext<InputAction>> {
               .with_auto_text_color(true)
               .with_font(UIComponent::DEFAULT_FONT, 16.0f)
               .with_flex_direction(FlexDirection::Column)
-              .with_debug_name(label + "_" + std::to_string(i)));
+              .with_debug_name(DebugName(item_prefix.c_str(), i)));
     }
   }
 
@@ -133,6 +136,7 @@ struct ExampleFlexAlignment : ScreenSystem<UIContext<InputAction>> {
 
     // Three boxes of different heights
     const float heights[] = {55.0f, 35.0f, 45.0f};
+    const std::string item_prefix = label + "_";
     for (int i = 0; i < 3; i++) {
       div(context, mk(container.ent(), i + 1),
           ComponentConfig{}
@@ -142,7 +146,7 @@ struct ExampleFlexAlignment : ScreenSystem<UIContext<InputAction>> {
               .with_auto_text_color(true)
               .with_font(UIComponent::DEFAULT_FONT, 18.0f)
               .with_flex_direction(FlexDirection::Column)
-              .with_debug_name(label + "_" + std::to_string(i)));
+              .with_debug_name(DebugName(item_prefix.c_str(), i)));
     }
   }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -8,7 +9,9 @@
 using namespace afterhours::ui;
 using namespace afterhours::ui::imm;
 
-struct ExampleNineSliceBordersScreen : ScreenSystem<UIContext<InputAction>> {
+struct ExampleNineSliceBordersScreen
+    : TexturedScreenSystem<ExampleNineSliceBordersScreen,
+                           UIContext<InputAction>> {
   // Fantasy parchment aesthetic
   afterhours::Color bg_dark{35, 28, 22, 255};       // Dark wood/leather
   afterhours::Color bg_medium{55, 45, 38, 255};     // Medium brown
@@ -17,9 +20,6 @@ struct ExampleNineSliceBordersScreen : ScreenSystem<UIContext<InputAction>> {
   afterhours::Color text_dark{45, 35, 25, 255};     // Dark text
   afterhours::Color text_light{235, 225, 210, 255}; // Light text
 
-  bool textures_loaded = false;
-  std::string base_path;
-
   // Panel textures - different styles
   raylib::Texture2D panel_000; // Simple rounded
   raylib::Texture2D panel_005; // Ornate corners
@@ -41,57 +41,37 @@ struct ExampleNineSliceBordersScreen : ScreenSystem<UIContext<InputAction>> {
   raylib::Texture2D double_panel_000;
   raylib::Texture2D double_panel_010;
 
-  void load_textures_if_needed() {
-    if (textures_loaded)
-      return;
-    textures_loaded = true;
-
-    base_path = afterhours::files::get_resource_path(
-                    "kenney", "kenney_fantasy-ui-borders/PNG")
-                    .string();
-
-    // Default panels
-    panel_000 = raylib::LoadTexture(
-        (base_path + "/Default/Panel/panel-000.png").c_str());
-    panel_005 = raylib::LoadTexture(
-        (base_path + "/Default/Panel/panel-005.png").c_str());
-    panel_010 = raylib::LoadTexture(
-        (base_path + "/Default/Panel/panel-010.png").c_str());
-    panel_015 = raylib::LoadTexture(
-        (base_path + "/Default/Panel/panel-015.png").c_str());
-    panel_020 = raylib::LoadTexture(
-        (base_path + "/Default/Panel/panel-020.png").c_str());
-    panel_025 = raylib::LoadTexture(
-        (base_path + "/Default/Panel/panel-025.png").c_str());
-
-    // Border-only (transparent center)
-    border_000 = raylib::LoadTexture(
-        (base_path + "/Default/Border/panel-border-000.png").c_str());
-    border_005 = raylib::LoadTexture(
-        (base_path + "/Default/Border/panel-border-005.png").c_str());
-    border_010 = raylib::LoadTexture(
-        (base_path + "/Default/Border/panel-border-010.png").c_str());
-
-    // Transparent border
-    trans_border_000 = raylib::LoadTexture(
-        (base_path +
-         "/Default/Transparent border/panel-transparent-border-000.png")
-            .c_str());
-    trans_border_010 = raylib::LoadTexture(
-        (base_path +
-         "/Default/Transparent border/panel-transparent-border-010.png")
-            .c_str());
-
-    // Double-width panels (thicker borders)
-    double_panel_000 = raylib::LoadTexture(
-        (base_path + "/Double/Panel/panel-000.png").c_str());
-    double_panel_010 = raylib::LoadTexture(
-        (base_path + "/Double/Panel/panel-010.png").c_str());
+  static const TextureTable<ExampleNineSliceBordersScreen> &texture_table() {
+    using Screen = ExampleNineSliceBordersScreen;
+    static const TextureTable<Screen> table = {
+        "kenney/kenney_fantasy-ui-borders/PNG",
+        {
+            // Default panels
+            {&Screen::panel_000, "Default/Panel/panel-000.png"},
+            {&Screen::panel_005, "Default/Panel/panel-005.png"},
+            {&Screen::panel_010, "Default/Panel/panel-010.png"},
+            {&Screen::panel_015, "Default/Panel/panel-015.png"},
+            {&Screen::panel_020, "Default/Panel/panel-020.png"},
+            {&Screen::panel_025, "Default/Panel/panel-025.png"},
+            // Border-only (transparent center)
+            {&Screen::border_000, "Default/Border/panel-border-000.png"},
+            {&Screen::border_005, "Default/Border/panel-border-005.png"},
+            {&Screen::border_010, "Default/Border/panel-border-010.png"},
+            // Transparent border
+            {&Screen::trans_border_000,
+             "Default/Transparent border/panel-transparent-border-000.png"},
+            {&Screen::trans_border_010,
+             "Default/Transparent border/panel-transparent-border-010.png"},
+            // Double-width panels (thicker borders)
+            {&Screen::double_panel_000, "Double/Panel/panel-000.png"},
+            {&Screen::double_panel_010, "Double/Panel/panel-010.png"},
+        }};
+    return table;
   }
 
   void for_each_with(afterhours::Entity &entity,
                      UIContext<InputAction> &context, float) override {
-    load_textures_if_needed();
+    load_textures();
 
     Theme theme;
     theme.font = text_light;
@@ -174,7 +154,7 @@ struct ExampleNineSliceBordersScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font(UIComponent::DEFAULT_FONT, 16.0f)
               .with_custom_text_color(text_dark)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("panel_" + std::to_string(i)));
+              .with_debug_name(DebugName("panel_", i)));
     }
 
     // Row 2: Border-only styles (transparent centers)
@@ -208,7 +188,7 @@ struct ExampleNineSliceBordersScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font(UIComponent::DEFAULT_FONT, 16.0f)
               .with_custom_text_color(text_light)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("border_" + std::to_string(i)));
+              .with_debug_name(DebugName("border_", i)));
     }
 
     // Row 3: Different sizes to show stretching
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -333,7 +334,7 @@ struct ExampleSeparators : ScreenSystem<UIContext<InputAction>> {
                 .with_absolute_position()
                 .with_translate(nav_x + sep_spacing, y + 12)
                 .with_custom_background(sep_colors[i])
-                .with_debug_name(std::string("vsep_") + std::to_string(i)));
+                .with_debug_name(DebugName("vsep_", i)));
         nav_x += sep_spacing * 2 + 3;
       }
     }
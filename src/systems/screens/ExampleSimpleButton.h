@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -67,7 +68,7 @@ struct ExampleSimpleButton : ScreenSystem<UIContext<InputAction>> {
                   afterhours::colors::opacity_pct(confetti[i % 4], 0.6f))
               .with_rounded_corners(std::bitset<4>(0b1111))
               .with_roundness(1.0f)
-              .with_debug_name("confetti_" + std::to_string(i)));
+              .with_debug_name(DebugName("confetti_", i)));
     }
 
     // Main card
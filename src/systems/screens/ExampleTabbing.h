@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -143,7 +144,7 @@ struct ExampleTabbing : ScreenSystem<UIContext<InputAction>> {
                      .with_rounded_corners(std::bitset<4>(0b1111))
                      .with_roundness(0.4f)
                      .with_alignment(TextAlignment::Center)
-                     .with_debug_name("tab_button_" + std::to_string(i)));
+                     .with_debug_name(DebugName("tab_button_", i)));
 
       if (button_result) {
         button_clicks[i]++;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -197,7 +198,7 @@ struct ExampleText : ScreenSystem<UIContext<InputAction>> {
                   afterhours::colors::darken(panel_dark, 0.85f))
               .with_rounded_corners(std::bitset<4>(0b1111))
               .with_roundness(0.2f)
-              .with_debug_name("color_bg_" + std::to_string(i)));
+              .with_debug_name(DebugName("color_bg_", i)));
 
       div(context, mk(entity, 31 + i * 2),
           ComponentConfig{}
@@ -207,7 +208,7 @@ struct ExampleText : ScreenSystem<UIContext<InputAction>> {
               .with_translate(right_col + 12.0f, content_y + 38.0f + i * 52.0f)
               .with_font("Garamond", 22.0f)
               .with_custom_text_color(examples[i].color)
-              .with_debug_name("color_text_" + std::to_string(i)));
+              .with_debug_name(DebugName("color_text_", i)));
     }
 
     // Footer
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -330,7 +331,7 @@ struct ExampleTextOverflow : ScreenSystem<UIContext<InputAction>> {
               .with_custom_background(card_bg)
               .with_rounded_corners(std::bitset<4>(0b1111))
               .with_border(i < 2 ? success_green : error_red, 2.0f)
-              .with_debug_name("shrink_box_" + std::to_string(i)));
+              .with_debug_name(DebugName("shrink_box_", i)));
 
       div(context, mk(entity, 41 + i * 2),
           ComponentConfig{}
@@ -341,7 +342,7 @@ struct ExampleTextOverflow : ScreenSystem<UIContext<InputAction>> {
               .with_font(UIComponent::DEFAULT_FONT, 16.0f)
               .with_custom_text_color(text_light)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("shrink_text_" + std::to_string(i)));
+              .with_debug_name(DebugName("shrink_text_", i)));
 
       box_x += size + 10.0f;
     }
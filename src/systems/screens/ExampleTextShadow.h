@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -279,7 +280,7 @@ struct ExampleTextShadow : ScreenSystem<UIContext<InputAction>> {
               .with_custom_text_color(purple)
               .with_text_shadow(purple_shadow, offsets[i], offsets[i])
               .with_alignment(TextAlignment::Left)
-              .with_debug_name("offset_" + std::to_string(i)));
+              .with_debug_name(DebugName("offset_", i)));
 
       div(context, mk(entity, id++),
           ComponentConfig{}
@@ -289,7 +290,7 @@ struct ExampleTextShadow : ScreenSystem<UIContext<InputAction>> {
               .with_translate(col2_x + 240.0f, offset_y + i * 75.0f + 12.0f)
               .with_font(UIComponent::DEFAULT_FONT, 18.0f)
               .with_custom_text_color(text_muted)
-              .with_debug_name("offset_label_" + std::to_string(i)));
+              .with_debug_name(DebugName("offset_label_", i)));
     }
 
     // ========== Code example at bottom ==========
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../ExampleScreenRegistry.h"
@@ -264,7 +265,7 @@ struct ExampleTextStroke : ScreenSystem<UIContext<InputAction>> {
               .with_custom_text_color(orange)
               .with_text_stroke(dark_orange, thicknesses[i])
               .with_alignment(TextAlignment::Left)
-              .with_debug_name("thickness_" + std::to_string(i)));
+              .with_debug_name(DebugName("thickness_", i)));
 
       div(context, mk(entity, id++),
           ComponentConfig{}
@@ -274,7 +275,7 @@ struct ExampleTextStroke : ScreenSystem<UIContext<InputAction>> {
               .with_translate(col2_x + 240.0f, thickness_y + i * 75.0f + 12.0f)
               .with_font(UIComponent::DEFAULT_FONT, 18.0f)
               .with_custom_text_color(text_muted)
-              .with_debug_name("thickness_label_" + std::to_string(i)));
+              .with_debug_name(DebugName("thickness_label_", i)));
     }
 
     // ========== Code example at bottom ==========
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -144,7 +145,7 @@ struct FighterMenuScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_font("EqProRounded", 19.0f)
                      .with_custom_text_color(text_color)
                      .with_alignment(TextAlignment::Center)
-                     .with_debug_name("tab_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("tab_", i)))) {
         selected_tab = i;
       }
     }
@@ -204,7 +205,7 @@ struct FighterMenuScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font("EqProRounded", 22.0f)
               .with_custom_text_color(icon_color)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("icon_" + std::to_string(i)));
+              .with_debug_name(DebugName("icon_", i)));
 
       // Menu item bar - black normally, bright green when selected
       afterhours::Color item_bg = is_selected ? menu_highlight : menu_item_bg;
@@ -223,7 +224,7 @@ struct FighterMenuScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_font("EqProRounded", 21.0f)
                      .with_custom_text_color(item_text)
                      .with_alignment(TextAlignment::Left)
-                     .with_debug_name("menu_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("menu_", i)))) {
         selected_option = i;
       }
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -74,7 +75,7 @@ struct FlightOptionsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_absolute_position()
               .with_translate(x, 0.0f)
               .with_custom_background(grid_color)
-              .with_debug_name("grid_v_" + std::to_string(i)));
+              .with_debug_name(DebugName("grid_v_", i)));
     }
     // Horizontal grid lines
     for (int i = 0; i < 15; i++) {
@@ -85,7 +86,7 @@ struct FlightOptionsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_absolute_position()
               .with_translate(0.0f, y)
               .with_custom_background(grid_color)
-              .with_debug_name("grid_h_" + std::to_string(i)));
+              .with_debug_name(DebugName("grid_h_", i)));
     }
 
     // ========== DECORATIVE HUD LINES ==========
@@ -132,7 +133,7 @@ struct FlightOptionsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(line_origin_x - 12.0f, tick_y)
               .with_custom_background(i == (int)selected_category ? text_cyan
                                                                   : text_muted)
-              .with_debug_name("tick_" + std::to_string(i)));
+              .with_debug_name(DebugName("tick_", i)));
     }
 
     // ========== TITLE: OPTIONS ==========
@@ -162,7 +163,7 @@ struct FlightOptionsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_translate(menu_x, menu_y + (float)i * 32.0f)
                      .with_font("EqProRounded", 19.0f)
                      .with_custom_text_color(item_color)
-                     .with_debug_name("cat_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("cat_", i)))) {
         selected_category = i;
       }
 
@@ -175,7 +176,7 @@ struct FlightOptionsScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_translate(menu_x - 18.0f,
                                 menu_y + (float)i * 32.0f + 3.0f)
                 .with_custom_background(text_cyan)
-                .with_debug_name("select_bar_" + std::to_string(i)));
+                .with_debug_name(DebugName("select_bar_", i)));
       }
     }
 
@@ -195,7 +196,7 @@ struct FlightOptionsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_translate(sub_x, sub_y + (float)i * 26.0f)
                      .with_font("EqProRounded", 19.0f)
                      .with_custom_text_color(opt_color)
-                     .with_debug_name("opt_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("opt_", i)))) {
         selected_option = i;
       }
     }
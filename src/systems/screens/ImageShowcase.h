@@ -5,15 +5,14 @@
 #include "../../theme_presets.h"
 #include "../ExampleScreenRegistry.h"
 #include <afterhours/ah.h>
-#include <afterhours/src/plugins/files.h>
 
 using namespace afterhours::ui;
 using namespace afterhours::ui::imm;
 
-struct ImageShowcase : ScreenSystem<UIContext<InputAction>> {
+struct ImageShowcase
+    : TexturedScreenSystem<ImageShowcase, UIContext<InputAction>> {
   // State for tracking interactions
   int button_clicks = 0;
-  bool textures_loaded = false;
 
   // Textures
   raylib::Texture2D gear_tex{};
@@ -22,19 +21,18 @@ struct ImageShowcase : ScreenSystem<UIContext<InputAction>> {
   raylib::Texture2D home_tex{};
   raylib::Texture2D play_tex{};
 
-  void load_textures() {
-    if (textures_loaded)
-      return;
-    textures_loaded = true;
-
-    std::string icon_path =
-        afterhours::files::get_resource_path("kenney/kenney_game-icons/PNG/White/2x/", "").string();
-
-    gear_tex = raylib::LoadTexture((icon_path + "gear.png").c_str());
-    star_tex = raylib::LoadTexture((icon_path + "star.png").c_str());
-    trophy_tex = raylib::LoadTexture((icon_path + "trophy.png").c_str());
-    home_tex = raylib::LoadTexture((icon_path + "home.png").c_str());
-    play_tex = raylib::LoadTexture((icon_path + "forward.png").c_str());
+  // Kenney game icons
+  static const TextureTable<ImageShowcase> &texture_table() {
+    static const TextureTable<ImageShowcase> table = {
+        "kenney/kenney_game-icons/PNG/White/2x",
+        {
+            {&ImageShowcase::gear_tex, "gear.png"},
+            {&ImageShowcase::star_tex, "star.png"},
+            {&ImageShowcase::trophy_tex, "trophy.png"},
+            {&ImageShowcase::home_tex, "home.png"},
+            {&ImageShowcase::play_tex, "forward.png"},
+        }};
+    return table;
   }
 
   void for_each_with(afterhours::Entity &entity, UIContext<InputAction> &context,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -83,29 +84,25 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
 
     // Top edge gradient (darker at top) - strong vignette
     ui_workarounds::vertical_gradient(context, entity, 1, 0.0f, 0.0f, sw,
-                                      sh * 0.3f, bg_olive_dark, bg_olive_mid,
-                                      8);
+                                      sh * 0.3f, bg_olive_dark, bg_olive_mid);
 
     // Bottom edge gradient (darker at bottom)
     ui_workarounds::vertical_gradient(context, entity, 10, 0.0f, sh * 0.7f, sw,
-                                      sh * 0.3f, bg_olive_mid, bg_olive_dark,
-                                      8);
+                                      sh * 0.3f, bg_olive_mid, bg_olive_dark);
 
     // Left edge gradient (darker at left)
     ui_workarounds::horizontal_gradient(
         context, entity, 20, 0.0f, 0.0f, sw * 0.2f, sh,
         afterhours::Color{bg_olive_dark.r, bg_olive_dark.g, bg_olive_dark.b,
                           200},
-        afterhours::Color{bg_olive_mid.r, bg_olive_mid.g, bg_olive_mid.b, 0},
-        6);
+        afterhours::Color{bg_olive_mid.r, bg_olive_mid.g, bg_olive_mid.b, 0});
 
     // Right edge gradient (darker at right)
     ui_workarounds::horizontal_gradient(
         context, entity, 30, sw * 0.8f, 0.0f, sw * 0.2f, sh,
         afterhours::Color{bg_olive_mid.r, bg_olive_mid.g, bg_olive_mid.b, 0},
         afterhours::Color{bg_olive_dark.r, bg_olive_dark.g, bg_olive_dark.b,
-                          200},
-        6);
+                          200});
 
     // ========== MAIN PANEL ==========
     // Inspiration: panel is narrower, taller, positioned in upper-center
@@ -314,7 +311,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(row_cream)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.55f)
-            .with_debug_name("row_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("row_", base_id)));
 
     // Label (left-aligned)
     div(context, mk(entity, base_id + 1),
@@ -325,7 +322,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_translate(x + 16.0f, y + 8.0f)
             .with_font("EqProRounded", 15.0f)
             .with_custom_text_color(text_dark)
-            .with_debug_name("label_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("label_", base_id)));
 
     // Left chevron (<) - clickable
     if (button(context, mk(entity, base_id + 2),
@@ -339,7 +336,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                    .with_custom_text_color(arrow_color)
                    .with_custom_background(afterhours::Color{0, 0, 0, 0})
                    .with_alignment(TextAlignment::Center)
-                   .with_debug_name("chevron_l_" + std::to_string(base_id)))) {
+                   .with_debug_name(DebugName("chevron_l_", base_id)))) {
       value_idx = (value_idx == 0) ? max_options - 1 : value_idx - 1;
     }
 
@@ -361,7 +358,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_font("EqProRounded", 15.0f)
             .with_custom_text_color(text_dark)
             .with_alignment(TextAlignment::Center)
-            .with_debug_name("value_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("value_", base_id)));
 
     // Right chevron (>) - clickable
     if (button(context, mk(entity, base_id + 4),
@@ -375,7 +372,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                    .with_custom_text_color(arrow_color)
                    .with_custom_background(afterhours::Color{0, 0, 0, 0})
                    .with_alignment(TextAlignment::Center)
-                   .with_debug_name("chevron_r_" + std::to_string(base_id)))) {
+                   .with_debug_name(DebugName("chevron_r_", base_id)))) {
       value_idx = (value_idx + 1) % max_options;
     }
   }
@@ -394,7 +391,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(row_cream)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.55f)
-            .with_debug_name("row_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("row_", base_id)));
 
     // Label (left-aligned)
     div(context, mk(entity, base_id + 1),
@@ -405,7 +402,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_translate(x + 16.0f, y + 8.0f)
             .with_font("EqProRounded", 15.0f)
             .with_custom_text_color(text_dark)
-            .with_debug_name("label_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("label_", base_id)));
 
     // Left chevron (<) - clickable
     if (button(context, mk(entity, base_id + 2),
@@ -419,7 +416,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                    .with_custom_text_color(arrow_color)
                    .with_custom_background(afterhours::Color{0, 0, 0, 0})
                    .with_alignment(TextAlignment::Center)
-                   .with_debug_name("chevron_l_" + std::to_string(base_id)))) {
+                   .with_debug_name(DebugName("chevron_l_", base_id)))) {
       if (value > 0)
         value--;
     }
@@ -448,8 +445,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_custom_background(seg_color)
                      .with_rounded_corners(std::bitset<4>(0b1111))
                      .with_roundness(0.2f)
-                     .with_debug_name("seg_" + std::to_string(base_id) + "_" +
-                                      std::to_string(i)))) {
+                     .with_debug_name(DebugName("seg_", base_id, i)))) {
         value = i + 1; // Set value to this segment
       }
     }
@@ -466,7 +462,7 @@ struct IslandsTrainsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                    .with_custom_text_color(arrow_color)
                    .with_custom_background(afterhours::Color{0, 0, 0, 0})
                    .with_alignment(TextAlignment::Center)
-                   .with_debug_name("chevron_r_" + std::to_string(base_id)))) {
+                   .with_debug_name(DebugName("chevron_r_", base_id)))) {
       if (value < max_val)
         value++;
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -124,7 +125,7 @@ struct KirbyOptionsScreen : ScreenSystem<UIContext<InputAction>> {
                   .with_roundness(0.25f)
                   .with_soft_shadow(2.0f, 3.0f, 8.0f,
                                     afterhours::Color{0, 0, 0, 40})
-                  .with_debug_name("tab_" + std::to_string(i)))) {
+                  .with_debug_name(DebugName("tab_", i)))) {
         selected_tab = i;
       }
     }
@@ -204,7 +205,7 @@ struct KirbyOptionsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_alignment(TextAlignment::Center)
               .with_rounded_corners(std::bitset<4>(0b1111))
               .with_roundness(0.2f)
-              .with_debug_name("tool_" + std::to_string(i)));
+              .with_debug_name(DebugName("tool_", i)));
     }
 
     // ========== NAME BUTTON (Yellow pill with avatar) ==========
@@ -311,7 +312,7 @@ struct KirbyOptionsScreen : ScreenSystem<UIContext<InputAction>> {
                   .with_roundness(0.25f)
                   .with_soft_shadow(2.0f, 3.0f, 8.0f,
                                     afterhours::Color{0, 0, 0, 30})
-                  .with_debug_name("opt_icon_" + std::to_string(i)))) {
+                  .with_debug_name(DebugName("opt_icon_", i)))) {
         selected_option = i;
       }
 
@@ -326,7 +327,7 @@ struct KirbyOptionsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font("Gaegu-Bold", 19.0f)
               .with_custom_text_color(text_dark)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("opt_label_" + std::to_string(i)));
+              .with_debug_name(DebugName("opt_label_", i)));
     }
 
     // ========== DESCRIPTION TEXT ==========
@@ -358,8 +359,7 @@ struct KirbyOptionsScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_translate(check_x + (float)col * 22.0f,
                                 check_y + (float)row * 22.0f)
                 .with_custom_background(c)
-                .with_debug_name("check_" + std::to_string(row) + "_" +
-                                 std::to_string(col)));
+                .with_debug_name(DebugName("check_", row, col)));
       }
     }
   }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -83,7 +84,7 @@ struct MiniMotorwaysSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_absolute_position()
               .with_translate(x, 0.0f)
               .with_custom_background(grid_line)
-              .with_debug_name("grid_v_" + std::to_string(i)));
+              .with_debug_name(DebugName("grid_v_", i)));
     }
 
     // Grid lines (horizontal)
@@ -95,7 +96,7 @@ struct MiniMotorwaysSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_absolute_position()
               .with_translate(0.0f, y)
               .with_custom_background(grid_line)
-              .with_debug_name("grid_h_" + std::to_string(i)));
+              .with_debug_name(DebugName("grid_h_", i)));
     }
 
     // ========== BACK ARROW ==========
@@ -135,7 +136,7 @@ struct MiniMotorwaysSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_absolute_position()
               .with_translate(line_x - 2.0f, tab_y + 22.0f)
               .with_custom_background(grid_line)
-              .with_debug_name("connector_" + std::to_string(i)));
+              .with_debug_name(DebugName("connector_", i)));
 
       // Tab button
       afterhours::Color tab_bg = selected ? highlight_yellow : tab_teal;
@@ -150,7 +151,7 @@ struct MiniMotorwaysSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_font("EqProRounded", 22.0f)
                      .with_custom_text_color(text_dark)
                      .with_alignment(TextAlignment::Center)
-                     .with_debug_name("tab_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("tab_", i)))) {
         selected_category = i;
       }
     }
@@ -174,7 +175,7 @@ struct MiniMotorwaysSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(content_x, row_y)
               .with_font("EqProRounded", 26.0f)
               .with_custom_text_color(text_dark)
-              .with_debug_name("label_" + std::to_string(i)));
+              .with_debug_name(DebugName("label_", i)));
 
       // Toggle circle
       std::string toggle_icon = is_on ? "V" : "X";
@@ -193,7 +194,7 @@ struct MiniMotorwaysSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_alignment(TextAlignment::Center)
                      .with_rounded_corners(std::bitset<4>(0b1111))
                      .with_roundness(1.0f)
-                     .with_debug_name("toggle_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("toggle_", i)))) {
         *(toggles[i].value) = !is_on;
       }
     }
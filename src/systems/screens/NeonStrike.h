@@ -1,11 +1,17 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
+#include "../../engine/render_cache.h"
+#include "../../engine/sprite_atlas.h"
+#include "../../engine/texture_cache.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
+#include "../../ui_workarounds/AtlasSprite.h"
 #include "../ExampleScreenRegistry.h"
 #include <afterhours/ah.h>
 #include <afterhours/src/plugins/files.h>
+#include <array>
 #include <cmath>
 
 using namespace afterhours::ui;
@@ -18,48 +24,74 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
   float health_pct = 0.8f;
   float armor_pct = 0.45f;
 
-  // Loaded textures
-  bool textures_loaded = false;
-  raylib::Texture2D icon_uav_tex{};
-  raylib::Texture2D icon_recon_tex{};
-  raylib::Texture2D icon_shield_tactical_tex{};
-  raylib::Texture2D icon_strike_tex{};
-  raylib::Texture2D icon_danger_tex{};
-  raylib::Texture2D icon_health_tex{};
-  raylib::Texture2D icon_skull_tex{};
-  raylib::Texture2D icon_ammo_tex{};
-  raylib::Texture2D weapon_grenade_tex{};
-  raylib::Texture2D weapon_melee_tex{};
-  raylib::Texture2D crosshair_tex{};
-
-  void load_textures_if_needed() {
-    if (textures_loaded)
-      return;
-    textures_loaded = true;
-
-    std::string images_path =
-        afterhours::files::get_resource_path("images", "").string();
-    icon_uav_tex = raylib::LoadTexture((images_path + "icon_uav.png").c_str());
-    icon_recon_tex =
-        raylib::LoadTexture((images_path + "icon_recon.png").c_str());
-    icon_shield_tactical_tex =
-        raylib::LoadTexture((images_path + "icon_shield_tactical.png").c_str());
-    icon_strike_tex =
-        raylib::LoadTexture((images_path + "icon_strike.png").c_str());
-    icon_danger_tex =
-        raylib::LoadTexture((images_path + "icon_danger.png").c_str());
-    icon_health_tex =
-        raylib::LoadTexture((images_path + "icon_health.png").c_str());
-    icon_skull_tex =
-        raylib::LoadTexture((images_path + "icon_skull.png").c_str());
-    icon_ammo_tex =
-        raylib::LoadTexture((images_path + "icon_ammo.png").c_str());
-    weapon_grenade_tex =
-        raylib::LoadTexture((images_path + "icon_grenade.png").c_str());
-    weapon_melee_tex =
-        raylib::LoadTexture((images_path + "icon_melee.png").c_str());
-    crosshair_tex =
-        raylib::LoadTexture((images_path + "crosshair_neon.png").c_str());
+  // Shared with other screens through texture_cache, holds the atlas pages
+  texture_cache::TextureSet textures;
+
+  // Sprites drawn with ui_workarounds::atlas_sprite, packed into the atlas
+  // by `make atlas`
+  static constexpr const char *UAV = "images/icon_uav.png";
+  static constexpr const char *RECON = "images/icon_recon.png";
+  static constexpr const char *SHIELD = "images/icon_shield_tactical.png";
+  static constexpr const char *STRIKE = "images/icon_strike.png";
+  static constexpr const char *DANGER = "images/icon_danger.png";
+  static constexpr const char *SKULL = "images/icon_skull.png";
+  static constexpr const char *GRENADE = "images/icon_grenade.png";
+  static constexpr const char *MELEE = "images/icon_melee.png";
+  static constexpr const char *CROSSHAIR = "images/crosshair_neon.png";
+  static constexpr std::array<const char *, 9> SPRITES = {
+      UAV, RECON, SHIELD, STRIKE, DANGER, SKULL, GRENADE, MELEE, CROSSHAIR};
+
+  std::vector<std::string> texture_paths() const override {
+    return sprite_atlas::files_for(SPRITES);
+  }
+
+  // The compass ticks and minimap grid are many tiny static elements, so
+  // they are drawn once with raylib into cached layers and shown as one
+  // sprite each. This is specific to this screen, not a general subtree
+  // cache: each key must cover every color and size its drawing reads.
+  render_cache::Layer compass_ticks;
+  render_cache::Layer minimap_grid;
+
+  // src over an opaque dst. raylib blends alpha into a layer's alpha
+  // channel too, so translucent colors are pre-blended against what lies
+  // beneath or the edges come out half transparent.
+  static afterhours::Color blend_over(afterhours::Color src,
+                                      afterhours::Color dst) {
+    auto mix = [&](unsigned char a, unsigned char b) {
+      return static_cast<unsigned char>((a * src.a + b * (255 - src.a)) / 255);
+    };
+    return afterhours::Color{mix(src.r, dst.r), mix(src.g, dst.g),
+                             mix(src.b, dst.b), 255};
+  }
+
+  static raylib::Color to_raylib(afterhours::Color c) {
+    return raylib::Color{c.r, c.g, c.b, c.a};
+  }
+
+  // Shows layer as a width x height sprite at (x, y), calling draw() to
+  // fill it first when key or size changed. draw() uses layer pixel
+  // coordinates.
+  template <typename Draw>
+  void cached_layer(UIContext<InputAction> &context,
+                    afterhours::Entity &entity, int id, render_cache::Layer &layer, uint64_t key, float x,
+                    float y, int width, int height, Draw &&draw,
+                    const char *debug_name) {
+    const raylib::Texture2D &texture =
+        layer.get(key, width, height, std::forward<Draw>(draw));
+    // Render textures are stored bottom-up
+    raylib::Rectangle source{0, 0, static_cast<float>(width),
+                             -static_cast<float>(height)};
+    sprite(context, mk(entity, id), texture, source,
+           ComponentConfig{}
+               .with_size(ComponentSize{pixels(width), pixels(height)})
+               .with_absolute_position()
+               .with_translate(x, y)
+               .with_debug_name(debug_name));
+  }
+
+  void prewarm() override {
+    for (const char *key : SPRITES)
+      sprite_atlas::load(textures, key);
   }
 
   // Colors matching the inspiration exactly - dark tactical feel
@@ -82,7 +114,6 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
 
   void for_each_with(afterhours::Entity &entity,
                      UIContext<InputAction> &context, float) override {
-    load_textures_if_needed();
     Theme theme;
     theme.font = text_tan;
     theme.darkfont = bg_dark;
@@ -179,28 +210,33 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
             .with_alignment(TextAlignment::Center)
             .with_debug_name("compass_needle"));
 
-    // Compass tick marks (8 positions around the ring)
+    // Compass tick marks (8 positions around the ring), baked into one layer
+    // centred on the ring
     float compass_cx = cx;
     float compass_cy = 60.0f;
     float compass_radius = 42.0f;
     float tick_size = 3.0f;
-    for (int i = 0; i < 8; i++) {
-      float angle = (float)i * 3.14159f / 4.0f;
-      float tick_x =
-          compass_cx + std::cos(angle) * compass_radius - tick_size / 2.0f;
-      float tick_y =
-          compass_cy + std::sin(angle) * compass_radius - tick_size / 2.0f;
-      div(context, mk(entity, 106 + i),
-          ComponentConfig{}
-              .with_size(ComponentSize{pixels(static_cast<int>(tick_size)),
-                                       pixels(static_cast<int>(tick_size))})
-              .with_absolute_position()
-              .with_translate(tick_x, tick_y)
-              .with_custom_background(text_muted)
-              .with_rounded_corners(std::bitset<4>(0b1111))
-              .with_roundness(1.0f)
-              .with_debug_name("compass_tick_" + std::to_string(i)));
-    }
+    int ticks_extent = static_cast<int>(2.0f * compass_radius + tick_size);
+    cached_layer(
+        context, entity, 106, compass_ticks,
+        render_cache::Key{}.add(text_muted).value(),
+        compass_cx - (float)ticks_extent / 2.0f,
+        compass_cy - (float)ticks_extent / 2.0f, ticks_extent, ticks_extent,
+        [&] {
+          float centre = (float)ticks_extent / 2.0f;
+          for (int i = 0; i < 8; i++) {
+            float angle = (float)i * 3.14159f / 4.0f;
+            raylib::DrawRectangleRounded(
+                raylib::Rectangle{
+                    centre + std::cos(angle) * compass_radius -
+                        tick_size / 2.0f,
+                    centre + std::sin(angle) * compass_radius -
+                        tick_size / 2.0f,
+                    tick_size, tick_size},
+                1.0f, 4, to_raylib(text_muted));
+          }
+        },
+        "compass_ticks");
 
     // ========== TOP RIGHT: Score & Objective ==========
     div(context, mk(entity, 110),
@@ -252,7 +288,7 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font("EqProRounded", 21.0f)
               .with_custom_text_color(text_muted)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("kill_" + std::to_string(i)));
+              .with_debug_name(DebugName("kill_", i)));
     }
 
     // ========== RIGHT: Voice Indicator ==========
@@ -268,19 +304,19 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
 
     // ========== LEFT: Killstreak Icons ==========
     // Array of skill textures and labels
-    std::vector<std::tuple<raylib::Texture2D *, std::string, std::string>>
+    std::vector<std::tuple<const char *, std::string, std::string>>
         skill_icons = {
-            {&icon_uav_tex, "[T]", "UAV"},
-            {&icon_recon_tex, "[O]", ""},
-            {&icon_shield_tactical_tex, "[U]", ""},
-            {&icon_strike_tex, "[X]", ""},
-            {&icon_danger_tex, "/!\\", ""},
+            {UAV, "[T]", "UAV"},
+            {RECON, "[O]", ""},
+            {SHIELD, "[U]", ""},
+            {STRIKE, "[X]", ""},
+            {DANGER, "/!\\", ""},
         };
 
     float ks_y = 140.0f;
     for (size_t i = 0; i < skill_icons.size(); i++) {
       float row_y = ks_y + (float)i * 72.0f;
-      auto &[tex_ptr, fallback_label, label] = skill_icons[i];
+      auto &[icon, fallback_label, label] = skill_icons[i];
 
       // Cog/gear icon
       div(context, mk(entity, 140 + static_cast<int>(i) * 3),
@@ -291,7 +327,7 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(22.0f, row_y + 18.0f)
               .with_font("EqProRounded", 19.0f)
               .with_custom_text_color(text_muted)
-              .with_debug_name("cog_" + std::to_string(i)));
+              .with_debug_name(DebugName("cog_", i)));
 
       // Icon box background
       div(context, mk(entity, 141 + static_cast<int>(i) * 3),
@@ -301,20 +337,16 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(45.0f, row_y)
               .with_custom_background(panel_dark)
               .with_border(border_dark, 1.0f)
-              .with_debug_name("ks_bg_" + std::to_string(i)));
+              .with_debug_name(DebugName("ks_bg_", i)));
 
       // Icon image or fallback text
-      if (tex_ptr && tex_ptr->id != 0) {
-        afterhours::texture_manager::Rectangle src{0, 0, (float)tex_ptr->width,
-                                                   (float)tex_ptr->height};
-        sprite(context, mk(entity, 142 + static_cast<int>(i) * 3), *tex_ptr,
-               src,
-               ComponentConfig{}
-                   .with_size(ComponentSize{pixels(40), pixels(40)})
-                   .with_absolute_position()
-                   .with_translate(52.5f, row_y + 7.5f)
-                   .with_debug_name("ks_icon_" + std::to_string(i)));
-      } else {
+      if (!ui_workarounds::atlas_sprite(
+              context, entity, 142 + static_cast<int>(i) * 3, textures, icon,
+              ComponentConfig{}
+                  .with_size(ComponentSize{pixels(40), pixels(40)})
+                  .with_absolute_position()
+                  .with_translate(52.5f, row_y + 7.5f)
+                  .with_debug_name(DebugName("ks_icon_", i)))) {
         div(context, mk(entity, 142 + static_cast<int>(i) * 3),
             ComponentConfig{}
                 .with_label(fallback_label)
@@ -324,7 +356,7 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_font("EqProRounded", 19.0f)
                 .with_custom_text_color(text_tan)
                 .with_alignment(TextAlignment::Center)
-                .with_debug_name("ks_icon_fallback_" + std::to_string(i)));
+                .with_debug_name(DebugName("ks_icon_fallback_", i)));
       }
 
       // Label (only for UAV)
@@ -338,7 +370,7 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_font("EqProRounded", 19.0f)
                 .with_custom_text_color(text_muted)
                 .with_alignment(TextAlignment::Center)
-                .with_debug_name("ks_label_" + std::to_string(i)));
+                .with_debug_name(DebugName("ks_label_", i)));
       }
     }
 
@@ -404,27 +436,24 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
             .with_border(border_dark, 2.0f)
             .with_debug_name("minimap"));
 
-    // Map grid lines (vertical)
-    for (int i = 1; i < 4; i++) {
-      div(context, mk(entity, 230 + i),
-          ComponentConfig{}
-              .with_size(ComponentSize{pixels(1), pixels(120)})
-              .with_absolute_position()
-              .with_translate(22.0f + (float)i * 43.0f, map_y + 26.0f)
-              .with_custom_background(afterhours::Color{60, 70, 60, 180})
-              .with_debug_name("grid_v_" + std::to_string(i)));
-    }
-
-    // Map grid lines (horizontal)
-    for (int i = 1; i < 3; i++) {
-      div(context, mk(entity, 240 + i),
-          ComponentConfig{}
-              .with_size(ComponentSize{pixels(160), pixels(1)})
-              .with_absolute_position()
-              .with_translate(30.0f, map_y + 18.0f + (float)i * 45.0f)
-              .with_custom_background(afterhours::Color{60, 70, 60, 180})
-              .with_debug_name("grid_h_" + std::to_string(i)));
-    }
+    // Map grid lines, baked into one layer over the minimap. Drawn opaque,
+    // pre-blended against the minimap background.
+    afterhours::Color grid_color =
+        blend_over(afterhours::Color{60, 70, 60, 180}, minimap_green);
+    cached_layer(
+        context, entity, 230, minimap_grid,
+        render_cache::Key{}.add(grid_color).value(), 30.0f, map_y + 26.0f,
+        160, 120,
+        [&] {
+          raylib::Color line = to_raylib(grid_color);
+          for (int i = 1; i < 4; i++) {
+            raylib::DrawRectangle(i * 43 - 8, 0, 1, 120, line);
+          }
+          for (int i = 1; i < 3; i++) {
+            raylib::DrawRectangle(0, i * 45 - 8, 160, 1, line);
+          }
+        },
+        "minimap_grid");
 
     // Red danger zone on map
     div(context, mk(entity, 250),
@@ -502,16 +531,13 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
             .with_debug_name("health_panel"));
 
     // Skull icon for health panel
-    if (icon_skull_tex.id != 0) {
-      afterhours::texture_manager::Rectangle src{
-          0, 0, (float)icon_skull_tex.width, (float)icon_skull_tex.height};
-      sprite(context, mk(entity, 311), icon_skull_tex, src,
-             ComponentConfig{}
-                 .with_size(ComponentSize{pixels(32), pixels(32)})
-                 .with_absolute_position()
-                 .with_translate(health_x + 10.0f, health_y + 14.0f)
-                 .with_debug_name("skull_icon"));
-    } else {
+    if (!ui_workarounds::atlas_sprite(
+            context, entity, 311, textures, SKULL,
+            ComponentConfig{}
+                .with_size(ComponentSize{pixels(32), pixels(32)})
+                .with_absolute_position()
+                .with_translate(health_x + 10.0f, health_y + 14.0f)
+                .with_debug_name("skull_icon"))) {
       div(context, mk(entity, 311),
           ComponentConfig{}
               .with_label("@")
@@ -596,17 +622,13 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(panel_dark)
             .with_border(gold_accent, 3.0f)
             .with_debug_name("grenade_bg"));
-    if (weapon_grenade_tex.id != 0) {
-      afterhours::texture_manager::Rectangle src{
-          0, 0, (float)weapon_grenade_tex.width,
-          (float)weapon_grenade_tex.height};
-      sprite(context, mk(entity, 411), weapon_grenade_tex, src,
-             ComponentConfig{}
-                 .with_size(ComponentSize{pixels(50), pixels(50)})
-                 .with_absolute_position()
-                 .with_translate(eq_x + 10.0f, eq_y + 10.0f)
-                 .with_debug_name("grenade_icon"));
-    }
+    ui_workarounds::atlas_sprite(
+        context, entity, 411, textures, GRENADE,
+        ComponentConfig{}
+            .with_size(ComponentSize{pixels(50), pixels(50)})
+            .with_absolute_position()
+            .with_translate(eq_x + 10.0f, eq_y + 10.0f)
+            .with_debug_name("grenade_icon"));
 
     // Knife (x1)
     div(context, mk(entity, 420),
@@ -617,16 +639,13 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(panel_dark)
             .with_border(border_dark, 2.0f)
             .with_debug_name("knife_bg"));
-    if (weapon_melee_tex.id != 0) {
-      afterhours::texture_manager::Rectangle src{
-          0, 0, (float)weapon_melee_tex.width, (float)weapon_melee_tex.height};
-      sprite(context, mk(entity, 422), weapon_melee_tex, src,
-             ComponentConfig{}
-                 .with_size(ComponentSize{pixels(50), pixels(50)})
-                 .with_absolute_position()
-                 .with_translate(eq_x + 90.0f, eq_y + 10.0f)
-                 .with_debug_name("knife_icon"));
-    }
+    ui_workarounds::atlas_sprite(
+        context, entity, 422, textures, MELEE,
+        ComponentConfig{}
+            .with_size(ComponentSize{pixels(50), pixels(50)})
+            .with_absolute_position()
+            .with_translate(eq_x + 90.0f, eq_y + 10.0f)
+            .with_debug_name("knife_icon"));
 
     div(context, mk(entity, 421),
         ComponentConfig{}
@@ -639,18 +658,15 @@ struct NeonStrikeScreen : ScreenSystem<UIContext<InputAction>> {
             .with_debug_name("x1"));
 
     // ========== CENTER: Crosshair ==========
-    if (crosshair_tex.id != 0) {
-      float cross_cx = (float)screen_w / 2.0f;
-      float cross_cy = (float)screen_h / 2.0f;
-      afterhours::texture_manager::Rectangle src{
-          0, 0, (float)crosshair_tex.width, (float)crosshair_tex.height};
-      sprite(context, mk(entity, 600), crosshair_tex, src,
-             ComponentConfig{}
-                 .with_size(ComponentSize{pixels(64), pixels(64)})
-                 .with_absolute_position()
-                 .with_translate(cross_cx - 32.0f, cross_cy - 32.0f)
-                 .with_debug_name("crosshair"));
-    }
+    float cross_cx = (float)screen_w / 2.0f;
+    float cross_cy = (float)screen_h / 2.0f;
+    ui_workarounds::atlas_sprite(
+        context, entity, 600, textures, CROSSHAIR,
+        ComponentConfig{}
+            .with_size(ComponentSize{pixels(64), pixels(64)})
+            .with_absolute_position()
+            .with_translate(cross_cx - 32.0f, cross_cy - 32.0f)
+            .with_debug_name("crosshair"));
   }
 };
 
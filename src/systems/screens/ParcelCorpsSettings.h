@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -409,7 +410,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(chat_x, chat_y)
               .with_font("EqProRounded", 12.0f)
               .with_custom_text_color(slider_orange)
-              .with_debug_name("chat_user_" + std::to_string(i)));
+              .with_debug_name(DebugName("chat_user_", i)));
 
       // Message
       div(context, mk(entity, 321 + static_cast<int>(i) * 2),
@@ -420,7 +421,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_translate(chat_x + 110.0f, chat_y)
               .with_font("EqProRounded", 12.0f)
               .with_custom_text_color(text_white)
-              .with_debug_name("chat_msg_" + std::to_string(i)));
+              .with_debug_name(DebugName("chat_msg_", i)));
     }
 
     // ========== SPEEDOMETER (bottom right) ==========
@@ -561,7 +562,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                    .with_custom_background(row_dark)
                    .with_rounded_corners(std::bitset<4>(0b1111))
                    .with_roundness(0.15f)
-                   .with_debug_name("toggle_row_" + std::to_string(base_id)))) {
+                   .with_debug_name(DebugName("toggle_row_", base_id)))) {
       value = !value; // Toggle the boolean on click
     }
 
@@ -578,7 +579,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_alignment(TextAlignment::Center)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("toggle_icon_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("toggle_icon_", base_id)));
 
     // Label
     div(context, mk(entity, base_id + 2),
@@ -589,7 +590,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_translate(x + 38.0f, y + 9.0f)
             .with_font("EqProRounded", 14.0f)
             .with_custom_text_color(text_white)
-            .with_debug_name("toggle_label_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("toggle_label_", base_id)));
 
     // Toggle track - smaller to fit reduced row height
     afterhours::Color track_color = value ? toggle_green : toggle_track;
@@ -601,7 +602,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(track_color)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.5f)
-            .with_debug_name("toggle_track_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("toggle_track_", base_id)));
 
     // Toggle knob
     float knob_x = value ? (x + w - 30.0f) : (x + w - 48.0f);
@@ -613,7 +614,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(text_white)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("toggle_knob_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("toggle_knob_", base_id)));
   }
 
   // Rainbow icon for Resolution/Full Screen rows
@@ -631,7 +632,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                    .with_custom_background(row_dark)
                    .with_rounded_corners(std::bitset<4>(0b1111))
                    .with_roundness(0.15f)
-                   .with_debug_name("toggle_row_" + std::to_string(base_id)))) {
+                   .with_debug_name(DebugName("toggle_row_", base_id)))) {
       value = !value; // Toggle the boolean on click
     }
 
@@ -644,7 +645,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(icon_rainbow1)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("rainbow_outer_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("rainbow_outer_", base_id)));
 
     div(context, mk(entity, base_id + 5),
         ComponentConfig{}
@@ -654,7 +655,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(icon_rainbow2)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("rainbow_mid_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("rainbow_mid_", base_id)));
 
     div(context, mk(entity, base_id + 6),
         ComponentConfig{}
@@ -664,7 +665,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(icon_rainbow3)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("rainbow_inner_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("rainbow_inner_", base_id)));
 
     // Label
     div(context, mk(entity, base_id + 2),
@@ -675,7 +676,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_translate(x + 38.0f, y + 9.0f)
             .with_font("EqProRounded", 14.0f)
             .with_custom_text_color(text_white)
-            .with_debug_name("toggle_label_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("toggle_label_", base_id)));
 
     // Toggle track - smaller for reduced row height
     afterhours::Color track_color = value ? toggle_green : toggle_track;
@@ -687,7 +688,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(track_color)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.5f)
-            .with_debug_name("toggle_track_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("toggle_track_", base_id)));
 
     // Toggle knob
     float knob_x = value ? (x + w - 30.0f) : (x + w - 48.0f);
@@ -699,7 +700,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(text_white)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("toggle_knob_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("toggle_knob_", base_id)));
   }
 
   void render_selector_row(UIContext<InputAction> &context,
@@ -717,7 +718,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(row_dark)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.15f)
-            .with_debug_name("selector_row_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("selector_row_", base_id)));
 
     // Icon
     div(context, mk(entity, base_id + 1),
@@ -732,7 +733,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_alignment(TextAlignment::Center)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("selector_icon_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("selector_icon_", base_id)));
 
     // Label
     div(context, mk(entity, base_id + 2),
@@ -743,7 +744,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_translate(x + 38.0f, y + 9.0f)
             .with_font("EqProRounded", 14.0f)
             .with_custom_text_color(text_white)
-            .with_debug_name("selector_label_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("selector_label_", base_id)));
 
     // Left arrow <
     if (button(
@@ -756,7 +757,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_font("EqProRounded", 14.0f)
                 .with_custom_text_color(text_muted)
                 .with_custom_background(afterhours::Color{0, 0, 0, 0})
-                .with_debug_name("selector_left_" + std::to_string(base_id)))) {
+                .with_debug_name(DebugName("selector_left_", base_id)))) {
       option_idx = (option_idx == 0) ? options.size() - 1 : option_idx - 1;
     }
 
@@ -770,7 +771,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_font("EqProRounded", 14.0f)
             .with_custom_text_color(text_white)
             .with_alignment(TextAlignment::Center)
-            .with_debug_name("selector_value_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("selector_value_", base_id)));
 
     // Right arrow >
     if (button(context, mk(entity, base_id + 5),
@@ -782,8 +783,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                    .with_font("EqProRounded", 14.0f)
                    .with_custom_text_color(text_muted)
                    .with_custom_background(afterhours::Color{0, 0, 0, 0})
-                   .with_debug_name("selector_right_" +
-                                    std::to_string(base_id)))) {
+                   .with_debug_name(DebugName("selector_right_", base_id)))) {
       option_idx = (option_idx + 1) % options.size();
     }
   }
@@ -803,7 +803,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(row_dark)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.15f)
-            .with_debug_name("display_row_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("display_row_", base_id)));
 
     // Icon
     div(context, mk(entity, base_id + 1),
@@ -818,7 +818,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_alignment(TextAlignment::Center)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("display_icon_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("display_icon_", base_id)));
 
     // Label
     div(context, mk(entity, base_id + 2),
@@ -829,7 +829,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_translate(x + 38.0f, y + 9.0f)
             .with_font("EqProRounded", 14.0f)
             .with_custom_text_color(text_white)
-            .with_debug_name("display_label_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("display_label_", base_id)));
 
     // Value
     div(context, mk(entity, base_id + 3),
@@ -841,7 +841,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_font("EqProRounded", 14.0f)
             .with_custom_text_color(text_muted)
             .with_alignment(TextAlignment::Right)
-            .with_debug_name("display_value_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("display_value_", base_id)));
   }
 
   void render_display_row_rainbow(UIContext<InputAction> &context,
@@ -859,7 +859,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(row_dark)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.15f)
-            .with_debug_name("display_row_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("display_row_", base_id)));
 
     // Rainbow icon (multicolor circle) - smaller to match other icons
     div(context, mk(entity, base_id + 1),
@@ -870,7 +870,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(icon_rainbow1)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("rainbow_outer_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("rainbow_outer_", base_id)));
 
     div(context, mk(entity, base_id + 5),
         ComponentConfig{}
@@ -880,7 +880,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(icon_rainbow2)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("rainbow_mid_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("rainbow_mid_", base_id)));
 
     div(context, mk(entity, base_id + 6),
         ComponentConfig{}
@@ -890,7 +890,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(icon_rainbow3)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("rainbow_inner_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("rainbow_inner_", base_id)));
 
     // Label
     div(context, mk(entity, base_id + 2),
@@ -901,7 +901,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_translate(x + 38.0f, y + 9.0f)
             .with_font("EqProRounded", 14.0f)
             .with_custom_text_color(text_white)
-            .with_debug_name("display_label_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("display_label_", base_id)));
 
     // Value
     div(context, mk(entity, base_id + 3),
@@ -913,7 +913,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_font("EqProRounded", 14.0f)
             .with_custom_text_color(text_muted)
             .with_alignment(TextAlignment::Right)
-            .with_debug_name("display_value_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("display_value_", base_id)));
   }
 
   void render_volume_slider(UIContext<InputAction> &context,
@@ -930,7 +930,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(row_dark)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.15f)
-            .with_debug_name("volume_row_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("volume_row_", base_id)));
 
     // Icon (speaker/music note in red)
     div(context, mk(entity, base_id + 1),
@@ -945,7 +945,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_alignment(TextAlignment::Center)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(1.0f)
-            .with_debug_name("volume_icon_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("volume_icon_", base_id)));
 
     // Label
     div(context, mk(entity, base_id + 2),
@@ -956,7 +956,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_translate(x + 38.0f, y + 9.0f)
             .with_font("EqProRounded", 14.0f)
             .with_custom_text_color(text_white)
-            .with_debug_name("volume_label_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("volume_label_", base_id)));
 
     // Visual slider track and handle (custom rendering for absolute
     // positioning)
@@ -975,7 +975,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(slider_track)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.5f)
-            .with_debug_name("volume_track_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("volume_track_", base_id)));
 
     // Filled portion
     float fill_w = slider_w * value;
@@ -989,7 +989,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_custom_background(slider_green)
               .with_rounded_corners(std::bitset<4>(0b1111))
               .with_roundness(0.5f)
-              .with_debug_name("volume_fill_" + std::to_string(base_id)));
+              .with_debug_name(DebugName("volume_fill_", base_id)));
     }
 
     // Handle
@@ -1004,7 +1004,7 @@ struct ParcelCorpsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
             .with_custom_background(text_white)
             .with_rounded_corners(std::bitset<4>(0b1111))
             .with_roundness(0.5f)
-            .with_debug_name("volume_handle_" + std::to_string(base_id)));
+            .with_debug_name(DebugName("volume_handle_", base_id)));
   }
 };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -230,7 +231,7 @@ struct PowerWashSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_translate(row_x, ry)
                      .with_font("EqProRounded", 16.0f)
                      .with_custom_text_color(label_color)
-                     .with_debug_name("label_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("label_", i)))) {
         selected_row = i;
       }
 
@@ -252,7 +253,7 @@ struct PowerWashSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_font("EqProRounded", 16.0f)
                      .with_custom_text_color(arrow_color)
                      .with_alignment(TextAlignment::Center)
-                     .with_debug_name("left_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("left_", i)))) {
         selected_row = i;
         auto &setting = current_settings[i];
         setting.option_idx = (setting.option_idx == 0)
@@ -273,7 +274,7 @@ struct PowerWashSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_font("EqProRounded", 14.0f)
               .with_custom_text_color(text_white)
               .with_alignment(TextAlignment::Center)
-              .with_debug_name("value_" + std::to_string(i)));
+              .with_debug_name(DebugName("value_", i)));
 
       // Right arrow >
       if (button(context, mk(entity, 53 + static_cast<int>(i) * 4),
@@ -288,7 +289,7 @@ struct PowerWashSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_font("EqProRounded", 16.0f)
                      .with_custom_text_color(arrow_color)
                      .with_alignment(TextAlignment::Center)
-                     .with_debug_name("right_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("right_", i)))) {
         selected_row = i;
         auto &setting = current_settings[i];
         setting.option_idx = (setting.option_idx + 1) % setting.options.size();
@@ -389,7 +390,7 @@ struct PowerWashSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                   .with_font("EqProRounded", 14.0f)
                   .with_custom_text_color(tab_text)
                   .with_alignment(TextAlignment::Center)
-                  .with_debug_name("tab_" + std::to_string(i)))) {
+                  .with_debug_name(DebugName("tab_", i)))) {
         selected_tab = i;
       }
 
@@ -402,7 +403,7 @@ struct PowerWashSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_absolute_position()
                 .with_translate(tx + 2.0f, tab_y + tab_h - 5.0f)
                 .with_custom_background(highlight_blue)
-                .with_debug_name("tab_underline_" + std::to_string(i)));
+                .with_debug_name(DebugName("tab_underline_", i)));
       }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -164,7 +165,7 @@ struct RubberBanditsMenuScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_translate(menu_x - 25.0f, item_y)
                 .with_font("EqProRounded", 22.0f)
                 .with_custom_text_color(text_dark)
-                .with_debug_name("arrow_" + std::to_string(i)));
+                .with_debug_name(DebugName("arrow_", i)));
       }
 
       if (button(context, mk(entity, 100 + static_cast<int>(i)),
@@ -175,7 +176,7 @@ struct RubberBanditsMenuScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_translate(menu_x, item_y)
                      .with_font("EqProRounded", 22.0f)
                      .with_custom_text_color(item_color)
-                     .with_debug_name("menu_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("menu_", i)))) {
         selected_item = i;
       }
     }
@@ -328,7 +329,7 @@ struct RubberBanditsMenuScreen : ScreenSystem<UIContext<InputAction>> {
               .with_alignment(TextAlignment::Center)
               .with_rounded_corners(std::bitset<4>(0b1111))
               .with_roundness(0.5f)
-              .with_debug_name("coin_" + std::to_string(i)));
+              .with_debug_name(DebugName("coin_", i)));
     }
   }
 };
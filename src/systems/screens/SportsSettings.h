@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -337,7 +338,7 @@ struct SportsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                       afterhours::Color{0, 0, 0, 0}) // Transparent bg
                   .with_alignment(TextAlignment::Center)
                   .with_skip_tabbing(true)
-                  .with_debug_name("tab_" + std::to_string(i)))) {
+                  .with_debug_name(DebugName("tab_", i)))) {
         selected_tab = i;
       }
 
@@ -350,7 +351,7 @@ struct SportsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_absolute_position()
                 .with_translate(tx + 5.0f, tab_y + tab_h + 2.0f)
                 .with_custom_background(accent_green)
-                .with_debug_name("tab_underline_" + std::to_string(i)));
+                .with_debug_name(DebugName("tab_underline_", i)));
       }
     }
 
@@ -428,7 +429,7 @@ struct SportsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                                           ? highlight_row
                                           : afterhours::Color{35, 45, 55, 255})
               .with_render_layer(-1)
-              .with_debug_name("row_bg_" + std::to_string(i)));
+              .with_debug_name(DebugName("row_bg_", i)));
 
       // Selection indicator - left border accent
       if (is_selected) {
@@ -440,7 +441,7 @@ struct SportsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                 .with_translate(panel_x - 15.0f, ry + 3.0f)
                 .with_custom_background(accent_green)
                 .with_render_layer(1)
-                .with_debug_name("row_accent_" + std::to_string(i)));
+                .with_debug_name(DebugName("row_accent_", i)));
       }
 
       // Label button - click to select row (this is tabbable)
@@ -454,7 +455,7 @@ struct SportsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_font("EqProRounded", 16.0f)
                      .with_custom_text_color(label_color)
                      .with_custom_background(afterhours::Color{0, 0, 0, 0})
-                     .with_debug_name("label_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("label_", i)))) {
         selected_row = i;
       }
 
@@ -476,7 +477,7 @@ struct SportsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_custom_background(afterhours::Color{0, 0, 0, 0})
                      .with_skip_tabbing(true)
                      .with_render_layer(2)
-                     .with_debug_name("left_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("left_", i)))) {
         selected_row = i;
         if (setting.is_slider) {
           setting.slider_pct = std::max(0.0f, setting.slider_pct - step);
@@ -499,7 +500,7 @@ struct SportsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
               .with_alignment(TextAlignment::Center)
               .with_skip_tabbing(true)
               .with_render_layer(2)
-              .with_debug_name("value_" + std::to_string(i)));
+              .with_debug_name(DebugName("value_", i)));
 
       // Right arrow > (skip tabbing - use row's keyboard handling) - render
       // above button
@@ -515,7 +516,7 @@ struct SportsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                      .with_custom_background(afterhours::Color{0, 0, 0, 0})
                      .with_skip_tabbing(true)
                      .with_render_layer(2)
-                     .with_debug_name("right_" + std::to_string(i)))) {
+                     .with_debug_name(DebugName("right_", i)))) {
         selected_row = i;
         if (setting.is_slider) {
           setting.slider_pct = std::min(1.0f, setting.slider_pct + step);
@@ -534,7 +535,7 @@ struct SportsSettingsScreen : ScreenSystem<UIContext<InputAction>> {
                    .with_absolute_position()
                    .with_translate(value_x + arrow_size + 170.0f, ry + 13.0f)
                    .with_skip_tabbing(true)
-                   .with_debug_name("slider_" + std::to_string(i)));
+                   .with_debug_name(DebugName("slider_", i)));
       }
     }
 
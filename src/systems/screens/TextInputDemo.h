@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/glyph_atlas.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -97,7 +98,13 @@ struct TextInputDemo : ScreenSystem<UIContext<InputAction>> {
         input_config.with_mask_char(*mask);
       }
 
-      return text_input(context, mk(form_container.ent(), idx * 2 + 1), value, input_config);
+      bool changed = text_input(context, mk(form_container.ent(), idx * 2 + 1),
+                                value, input_config);
+      // The field draws value, not a label, so its glyphs are requested here
+      if (!mask) {
+        glyph_atlas::request_text(value);
+      }
+      return changed;
     };
 
     // Username input
@@ -140,6 +147,7 @@ struct TextInputDemo : ScreenSystem<UIContext<InputAction>> {
                        .with_debug_name("search_input"))) {
       status_message = "Searching for: " + search_query;
     }
+    glyph_atlas::request_text(search_query);
 
     // Submit button
     if (button(context, mk(form_container.ent(), 9),
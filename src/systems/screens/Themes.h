@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../engine/debug_name.h"
 #include "../../external.h"
 #include "../../input_mapping.h"
 #include "../../theme_presets.h"
@@ -10,6 +11,9 @@ using namespace afterhours::ui;
 using namespace afterhours::ui::imm;
 
 struct ThemesScreen : ScreenSystem<UIContext<InputAction>> {
+  // Only changes in response to input
+  bool needs_redraw() const override { return false; }
+
   enum struct ThemeChoice {
     CozyKraft,
     NeonDark,
@@ -153,7 +157,7 @@ struct ThemesScreen : ScreenSystem<UIContext<InputAction>> {
                                             : Theme::Usage::Secondary)
                   .with_font(UIComponent::DEFAULT_FONT, 18.0f)
                   .with_margin(Spacing::sm)
-                  .with_debug_name("theme_btn_" + std::to_string(btn_idx)))) {
+                  .with_debug_name(DebugName("theme_btn_", btn_idx)))) {
         current_theme = choice;
       }
       btn_idx++;
@@ -0,0 +1,190 @@
+#include "baseline_cache.h"
+
+#include "../engine/cache_file.h"
+#include "../log.h"
+#include "../rl.h"
+#include "image_diff.h"
+
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+namespace baseline_cache {
+
+namespace {
+
+constexpr char kMagic[4] = {'A', 'H', 'B', 'C'};
+constexpr uint32_t kVersion = 2;
+
+// On-disk header, followed by tile_count image_diff tile hashes at
+// tile_offset and the RGBA8 pixels at pixel_offset
+struct CacheHeader {
+  char magic[4];
+  uint32_t version;
+  int32_t width;
+  int32_t height;
+  int32_t format;
+  uint32_t pixel_offset;
+  uint64_t source_size;
+  int64_t source_mtime;
+  uint64_t source_hash;
+  int32_t tile_size;
+  uint32_t tile_count;
+  uint32_t tile_offset;
+  uint32_t reserved;
+};
+
+size_t pixel_bytes(int width, int height) {
+  return static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+}
+
+const CacheHeader *read_header(const mapped_file::MappedFile &file) {
+  if (file.size() < sizeof(CacheHeader))
+    return nullptr;
+  const auto *header = reinterpret_cast<const CacheHeader *>(file.data());
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion ||
+      header->format != raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 ||
+      header->width <= 0 || header->height <= 0 ||
+      header->pixel_offset < sizeof(CacheHeader))
+    return nullptr;
+  if (file.size() <
+      header->pixel_offset + pixel_bytes(header->width, header->height))
+    return nullptr;
+  // Hashes from a different tile layout are useless, treat as stale
+  if (header->tile_size != image_diff::kTileSize ||
+      header->tile_count != static_cast<uint32_t>(image_diff::tile_count(
+                                header->width, header->height)) ||
+      header->tile_offset < sizeof(CacheHeader) ||
+      header->tile_offset + header->tile_count * sizeof(uint64_t) >
+          header->pixel_offset)
+    return nullptr;
+  return header;
+}
+
+bool write_cache(const std::string &cache_path,
+                 const cache_file::SourceStamp &source, uint64_t hash,
+                 const uint8_t *rgba, int width, int height) {
+  std::vector<uint64_t> tiles(
+      static_cast<size_t>(image_diff::tile_count(width, height)));
+  image_diff::hash_tiles(rgba, width, height, tiles.data());
+  const size_t tile_bytes = tiles.size() * sizeof(uint64_t);
+
+  CacheHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.width = width;
+  header.height = height;
+  header.format = raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+  header.tile_size = image_diff::kTileSize;
+  header.tile_count = static_cast<uint32_t>(tiles.size());
+  header.tile_offset = static_cast<uint32_t>(sizeof(CacheHeader));
+  header.pixel_offset =
+      static_cast<uint32_t>(sizeof(CacheHeader) + tile_bytes);
+  header.source_size = source.size;
+  header.source_mtime = source.mtime;
+  header.source_hash = hash;
+
+  return cache_file::write_atomic(
+      cache_path,
+      {cache_file::bytes_of(header),
+       {reinterpret_cast<const uint8_t *>(tiles.data()), tile_bytes},
+       {rgba, pixel_bytes(width, height)}});
+}
+
+bool map_cache(const std::string &cache_path,
+               const cache_file::SourceStamp &source,
+               const std::string &png_path, mapped_file::MappedFile &file,
+               const CacheHeader *&header) {
+  if (!file.open(cache_path))
+    return false;
+  header = read_header(file);
+  if (!header ||
+      !cache_file::source_matches(
+          png_path, source,
+          cache_file::SourceStamp{header->source_size, header->source_mtime},
+          header->source_hash)) {
+    file.close();
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+Baseline::~Baseline() { reset(); }
+
+void Baseline::reset() {
+  file_.close();
+  if (decoded_) {
+    raylib::MemFree(decoded_);
+    decoded_ = nullptr;
+  }
+  pixels_ = nullptr;
+  tile_hashes_ = nullptr;
+  width_ = 0;
+  height_ = 0;
+}
+
+std::string cache_path_for(const std::string &png_path) {
+  std::filesystem::path png(png_path);
+  return (png.parent_path() / ".cache" / png.stem()).string() + ".rgba";
+}
+
+bool load(const std::string &png_path, Baseline &out) {
+  out.reset();
+
+  cache_file::SourceStamp source;
+  if (!cache_file::stamp_source(png_path, source))
+    return false;
+
+  auto use_cache = [&out](const CacheHeader &header) {
+    const uint8_t *base = out.file_.data();
+    out.tile_hashes_ =
+        reinterpret_cast<const uint64_t *>(base + header.tile_offset);
+    out.pixels_ = base + header.pixel_offset;
+    out.width_ = header.width;
+    out.height_ = header.height;
+  };
+
+  std::string cache_path = cache_path_for(png_path);
+  const CacheHeader *header = nullptr;
+  if (map_cache(cache_path, source, png_path, out.file_, header)) {
+    use_cache(*header);
+    return true;
+  }
+
+  // Cache missing or stale: decode the png once and refresh the cache
+  raylib::Image image = raylib::LoadImage(png_path.c_str());
+  if (image.data == nullptr)
+    return false;
+  raylib::ImageFormat(&image, raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+  const auto *rgba = static_cast<const uint8_t *>(image.data);
+  if (write_cache(cache_path, source, cache_file::hash_file(png_path), rgba,
+                  image.width, image.height) &&
+      map_cache(cache_path, source, png_path, out.file_, header)) {
+    raylib::UnloadImage(image);
+    use_cache(*header);
+    return true;
+  }
+
+  log_warn("[baseline_cache] Could not write cache for {}", png_path);
+  out.decoded_ = image.data;
+  out.pixels_ = rgba;
+  out.width_ = image.width;
+  out.height_ = image.height;
+  return true;
+}
+
+bool store(const std::string &png_path, const uint8_t *rgba, int width,
+           int height) {
+  cache_file::SourceStamp source;
+  if (!rgba || width <= 0 || height <= 0 ||
+      !cache_file::stamp_source(png_path, source))
+    return false;
+  return write_cache(cache_path_for(png_path), source,
+                     cache_file::hash_file(png_path), rgba, width, height);
+}
+
+} // namespace baseline_cache
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../engine/mapped_file.h"
+
+#include <cstdint>
+#include <string>
+
+namespace baseline_cache {
+
+// A decoded RGBA8 baseline. Pixels point into an mmap'd cache file, or into
+// a freshly decoded image when the cache could not be written.
+class Baseline {
+public:
+  Baseline() = default;
+  ~Baseline();
+
+  Baseline(const Baseline &) = delete;
+  Baseline &operator=(const Baseline &) = delete;
+
+  bool valid() const { return pixels_ != nullptr; }
+  const uint8_t *pixels() const { return pixels_; }
+  // image_diff tile hashes of the pixels, or nullptr when not cached
+  const uint64_t *tile_hashes() const { return tile_hashes_; }
+  int width() const { return width_; }
+  int height() const { return height_; }
+
+private:
+  friend bool load(const std::string &png_path, Baseline &out);
+
+  void reset();
+
+  mapped_file::MappedFile file_;
+  // Owned decode when running without a cache file
+  void *decoded_ = nullptr;
+  const uint8_t *pixels_ = nullptr;
+  const uint64_t *tile_hashes_ = nullptr;
+  int width_ = 0;
+  int height_ = 0;
+};
+
+// Cache file used for a baseline png: <dir>/.cache/<name>.rgba
+std::string cache_path_for(const std::string &png_path);
+
+// Loads the baseline for png_path, decoding the png and refreshing the cache
+// only when the png changed since the cache was written
+bool load(const std::string &png_path, Baseline &out);
+
+// Writes the cache (pixels plus tile hashes) for a png that was just saved
+// from these RGBA8 pixels
+bool store(const std::string &png_path, const uint8_t *rgba, int width,
+           int height);
+
+} // namespace baseline_cache
@@ -4,6 +4,9 @@
 
 #include "e2e_commands.h"
 
+#include <charconv>
+#include <cstring>
+
 #include <afterhours/src/plugins/e2e_testing/e2e_testing.h>
 
 namespace e2e {
@@ -88,6 +91,11 @@ struct E2EArgs {
   bool slow_mode = false;        // Run tests slowly for visibility
   float slow_delay = 0.5f;       // Delay between commands in slow mode
   bool update_baselines = false; // Update baseline screenshots instead of comparing
+  bool headless = false;         // Hidden window, uncapped, fixed dt
+  bool fast_forward = false;     // Skip rendering frames that only pass time
+  int jobs = 1;                  // Worker processes for --test-script-dir
+  bool worker = false;           // Child of a --jobs run, leaves settings alone
+  std::string error;             // Usage error, empty when the args are fine
 };
 
 inline E2EArgs parse_e2e_args(int argc, char *argv[]) {
@@ -112,6 +120,25 @@ inline E2EArgs parse_e2e_args(int argc, char *argv[]) {
       args.slow_mode = true;
     } else if (arg == "--update-baselines") {
       args.update_baselines = true;
+    } else if (arg == "--headless") {
+      // Nobody watches a headless run, so idle frames never need pixels
+      args.headless = true;
+      args.fast_forward = true;
+    } else if (arg == "--fast-forward") {
+      args.fast_forward = true;
+    } else if (arg == "--jobs") {
+      // from_chars rather than stoi, which throws on a non-number
+      const char *value = i + 1 < argc ? argv[++i] : "";
+      const char *end = value + std::strlen(value);
+      int jobs = 0;
+      auto [ptr, ec] = std::from_chars(value, end, jobs);
+      if (ec != std::errc{} || ptr != end || jobs < 1) {
+        args.error = "--jobs needs a whole number of at least 1";
+      } else {
+        args.jobs = jobs;
+      }
+    } else if (arg == "--e2e-worker") {
+      args.worker = true;
     }
   }
 
@@ -0,0 +1,277 @@
+#include "e2e_parallel.h"
+
+#include "../log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+#endif
+
+namespace e2e_parallel {
+
+#ifndef _WIN32
+namespace {
+
+struct ScriptResult {
+  std::string script;
+  bool passed = false;
+  int exit_code = -1;
+  double seconds = 0.0;
+  std::string output;
+};
+
+std::vector<std::string> find_scripts(const std::string &script_dir) {
+  std::vector<std::string> scripts;
+  std::error_code ec;
+  for (const auto &entry :
+       std::filesystem::directory_iterator(script_dir, ec)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".e2e") {
+      scripts.push_back(entry.path().string());
+    }
+  }
+  std::sort(scripts.begin(), scripts.end());
+  return scripts;
+}
+
+// Options that the coordinator handles itself and must not reach children
+std::vector<std::string> forwarded_args(int argc, char *argv[]) {
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--test-script-dir" || arg == "--jobs" ||
+        arg == "--slow-delay" || arg == "--trace-out") {
+      ++i;
+      continue;
+    }
+    if (arg == "--slow" || arg == "--headless" || arg == "--e2e-worker") {
+      continue;
+    }
+    // Workers would all write the same trace file
+    if (arg.rfind("--trace-out=", 0) == 0) {
+      continue;
+    }
+    args.push_back(arg);
+  }
+  return args;
+}
+
+void print_summary(const std::vector<ScriptResult> &results,
+                   double wall_seconds) {
+  int passed = 0;
+  double script_seconds = 0.0;
+  for (const ScriptResult &result : results) {
+    if (result.passed)
+      passed++;
+    script_seconds += result.seconds;
+  }
+
+  // Full output only for failures, passes would drown them out
+  for (const ScriptResult &result : results) {
+    if (result.passed)
+      continue;
+    std::cout << "\n===== " << result.script << " (exit " << result.exit_code
+              << ") =====\n"
+              << result.output;
+  }
+
+  std::cout << "\n========================================\n";
+  std::cout << "E2E Results (" << results.size() << " scripts)\n";
+  std::cout << "========================================\n";
+  for (const ScriptResult &result : results) {
+    char line[512];
+    std::snprintf(line, sizeof(line), "  [%s] %-48s %7.2fs\n",
+                  result.passed ? "PASS" : "FAIL",
+                  std::filesystem::path(result.script).filename().c_str(),
+                  result.seconds);
+    std::cout << line;
+  }
+  char totals[256];
+  std::snprintf(totals, sizeof(totals),
+                "Passed: %d/%zu  wall %.2fs  (script time %.2fs, %.1fx)\n",
+                passed, results.size(), wall_seconds, script_seconds,
+                wall_seconds > 0.0 ? script_seconds / wall_seconds : 0.0);
+  std::cout << totals;
+}
+
+struct Child {
+  pid_t pid = -1;
+  int fd = -1;
+  size_t index = 0;
+  std::chrono::steady_clock::time_point start;
+};
+
+bool spawn_child(const std::string &exe, const std::vector<std::string> &args,
+                 Child &child) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    log_error("[E2E] pipe failed: {}", errno);
+    return false;
+  }
+  // Later children must not inherit this read end
+  fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+
+  posix_spawn_file_actions_t actions;
+  posix_spawn_file_actions_init(&actions);
+  posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+  posix_spawn_file_actions_adddup2(&actions, fds[1], STDERR_FILENO);
+  posix_spawn_file_actions_addclose(&actions, fds[0]);
+  posix_spawn_file_actions_addclose(&actions, fds[1]);
+
+  std::vector<char *> child_argv;
+  child_argv.push_back(const_cast<char *>(exe.c_str()));
+  for (const std::string &arg : args) {
+    child_argv.push_back(const_cast<char *>(arg.c_str()));
+  }
+  child_argv.push_back(nullptr);
+
+  int rc = posix_spawnp(&child.pid, exe.c_str(), &actions, nullptr,
+                        child_argv.data(), environ);
+  posix_spawn_file_actions_destroy(&actions);
+  close(fds[1]);
+  if (rc != 0) {
+    close(fds[0]);
+    log_error("[E2E] Failed to spawn {}: {}", exe, rc);
+    return false;
+  }
+
+  child.fd = fds[0];
+  child.start = std::chrono::steady_clock::now();
+  return true;
+}
+
+int exit_code_of(int status) {
+  if (WIFEXITED(status))
+    return WEXITSTATUS(status);
+  if (WIFSIGNALED(status))
+    return 128 + WTERMSIG(status);
+  return -1;
+}
+
+} // namespace
+#endif
+
+bool is_supported() {
+#ifndef _WIN32
+  return true;
+#else
+  return false;
+#endif
+}
+
+int run_sharded(const std::string &script_dir, int jobs, int argc,
+                char *argv[]) {
+#ifndef _WIN32
+  std::vector<std::string> scripts = find_scripts(script_dir);
+  if (scripts.empty()) {
+    std::cout << "No E2E scripts found in " << script_dir << "\n";
+    return 1;
+  }
+
+  jobs = std::clamp(jobs, 1, static_cast<int>(scripts.size()));
+
+  const std::string exe = argv[0];
+  const std::vector<std::string> base_args = forwarded_args(argc, argv);
+
+  std::cout << "Running " << scripts.size() << " E2E scripts across " << jobs
+            << " workers...\n";
+
+  std::vector<ScriptResult> results(scripts.size());
+  std::vector<Child> running;
+  size_t next_script = 0;
+  auto wall_start = std::chrono::steady_clock::now();
+
+  while (next_script < scripts.size() || !running.empty()) {
+    // Hand the next script to any free slot
+    while (next_script < scripts.size() &&
+           static_cast<int>(running.size()) < jobs) {
+      size_t index = next_script++;
+      results[index].script = scripts[index];
+
+      std::vector<std::string> args = base_args;
+      args.insert(args.end(), {"--test-script", scripts[index], "--headless",
+                               "--e2e-worker"});
+      Child child;
+      child.index = index;
+      if (!spawn_child(exe, args, child)) {
+        results[index].output = "failed to spawn worker\n";
+        continue;
+      }
+      running.push_back(child);
+    }
+    if (running.empty())
+      continue;
+
+    std::vector<pollfd> fds;
+    for (const Child &child : running) {
+      fds.push_back(pollfd{child.fd, POLLIN, 0});
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR)
+        continue;
+      log_error("[E2E] poll failed: {}", errno);
+      break;
+    }
+
+    for (size_t i = fds.size(); i-- > 0;) {
+      if (fds[i].revents == 0)
+        continue;
+      Child &child = running[i];
+      ScriptResult &result = results[child.index];
+
+      char buffer[4096];
+      ssize_t n = read(child.fd, buffer, sizeof(buffer));
+      if (n > 0) {
+        result.output.append(buffer, static_cast<size_t>(n));
+        continue;
+      }
+      if (n < 0 && errno == EINTR)
+        continue;
+
+      // EOF: the child closed its output, collect its exit status
+      close(child.fd);
+      int status = 0;
+      waitpid(child.pid, &status, 0);
+      result.exit_code = exit_code_of(status);
+      result.passed = result.exit_code == 0;
+      result.seconds = std::chrono::duration<double>(
+                           std::chrono::steady_clock::now() - child.start)
+                           .count();
+      std::cout << (result.passed ? "  PASS " : "  FAIL ")
+                << std::filesystem::path(result.script).filename().string()
+                << std::endl;
+      running.erase(running.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+  }
+
+  double wall_seconds = std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - wall_start)
+                            .count();
+  print_summary(results, wall_seconds);
+
+  bool all_passed = std::all_of(
+      results.begin(), results.end(),
+      [](const ScriptResult &result) { return result.passed; });
+  return all_passed ? 0 : 1;
+#else
+  (void)script_dir;
+  (void)jobs;
+  (void)argc;
+  (void)argv;
+  return 1;
+#endif
+}
+
+} // namespace e2e_parallel
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+
+namespace e2e_parallel {
+
+// Whether this platform can run E2E scripts in child processes
+bool is_supported();
+
+// Runs every .e2e script in script_dir in its own headless ui_tester child,
+// keeping up to jobs (at least 1) children alive. Other
+// command line options (size, timeout, --update-baselines) are forwarded.
+// Prints a merged summary and returns the process exit code.
+int run_sharded(const std::string &script_dir, int jobs, int argc,
+                char *argv[]);
+
+} // namespace e2e_parallel
@@ -0,0 +1,537 @@
+#include "image_diff.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <emmintrin.h>
+#define IMAGE_DIFF_HAS_SSE2 1
+#if defined(__GNUC__) || defined(__clang__)
+#include <immintrin.h>
+#define IMAGE_DIFF_HAS_AVX2 1
+#endif
+#endif
+
+namespace image_diff {
+
+namespace {
+
+// Per-row accumulator; first/last are pixel offsets within the row
+struct RowAccum {
+  uint64_t sum = 0;
+  int changed = 0;
+  int first = -1;
+  int last = -1;
+};
+
+using RowFn = void (*)(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                       int count, uint8_t tolerance, RowAccum &acc);
+
+inline void note_changed_bits(unsigned bits, int x, int lanes, uint8_t *mask,
+                              RowAccum &acc) {
+  if (bits == 0) {
+    if (mask)
+      std::memset(mask + x, 0, static_cast<size_t>(lanes));
+    return;
+  }
+  acc.changed += std::popcount(bits);
+  int lo = x + std::countr_zero(bits);
+  int hi = x + std::bit_width(bits) - 1;
+  if (acc.first < 0)
+    acc.first = lo;
+  acc.last = hi;
+  if (mask) {
+    for (int i = 0; i < lanes; i++) {
+      mask[x + i] = ((bits >> i) & 1u) ? 255 : 0;
+    }
+  }
+}
+
+void diff_row_scalar_from(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                          int start, int count, uint8_t tolerance,
+                          RowAccum &acc) {
+  for (int x = start; x < count; x++) {
+    const uint8_t *pa = a + static_cast<size_t>(x) * 4;
+    const uint8_t *pb = b + static_cast<size_t>(x) * 4;
+    int dr = std::abs(static_cast<int>(pa[0]) - static_cast<int>(pb[0]));
+    int dg = std::abs(static_cast<int>(pa[1]) - static_cast<int>(pb[1]));
+    int db = std::abs(static_cast<int>(pa[2]) - static_cast<int>(pb[2]));
+    int da = std::abs(static_cast<int>(pa[3]) - static_cast<int>(pb[3]));
+    acc.sum += static_cast<uint64_t>(dr + dg + db);
+
+    bool changed = std::max(std::max(dr, dg), std::max(db, da)) > tolerance;
+    if (mask)
+      mask[x] = changed ? 255 : 0;
+    if (!changed)
+      continue;
+    acc.changed++;
+    if (acc.first < 0)
+      acc.first = x;
+    acc.last = x;
+  }
+}
+
+void diff_row_scalar(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                     int count, uint8_t tolerance, RowAccum &acc) {
+  diff_row_scalar_from(a, b, mask, 0, count, tolerance, acc);
+}
+
+#ifdef IMAGE_DIFF_HAS_SSE2
+void diff_row_sse2(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                   int count, uint8_t tolerance, RowAccum &acc) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+  const __m128i tol = _mm_set1_epi8(static_cast<char>(tolerance));
+  __m128i sum = _mm_setzero_si128();
+
+  int x = 0;
+  for (; x + 4 <= count; x += 4) {
+    __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + x * 4));
+    __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + x * 4));
+    __m128i ad = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+    sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_and_si128(ad, rgb_mask), zero));
+
+    __m128i same = _mm_cmpeq_epi32(_mm_subs_epu8(ad, tol), zero);
+    unsigned bits =
+        ~static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(same))) & 0xFu;
+    note_changed_bits(bits, x, 4, mask, acc);
+  }
+
+  alignas(16) uint64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), sum);
+  acc.sum += lanes[0] + lanes[1];
+
+  diff_row_scalar_from(a, b, mask, x, count, tolerance, acc);
+}
+#endif
+
+#ifdef IMAGE_DIFF_HAS_AVX2
+__attribute__((target("avx2"))) void
+diff_row_avx2(const uint8_t *a, const uint8_t *b, uint8_t *mask, int count,
+              uint8_t tolerance, RowAccum &acc) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i rgb_mask = _mm256_set1_epi32(0x00FFFFFF);
+  const __m256i tol = _mm256_set1_epi8(static_cast<char>(tolerance));
+  __m256i sum = _mm256_setzero_si256();
+
+  int x = 0;
+  for (; x + 8 <= count; x += 8) {
+    __m256i va =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + x * 4));
+    __m256i vb =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + x * 4));
+    __m256i ad =
+        _mm256_or_si256(_mm256_subs_epu8(va, vb), _mm256_subs_epu8(vb, va));
+    sum = _mm256_add_epi64(sum,
+                           _mm256_sad_epu8(_mm256_and_si256(ad, rgb_mask), zero));
+
+    __m256i same = _mm256_cmpeq_epi32(_mm256_subs_epu8(ad, tol), zero);
+    unsigned bits = ~static_cast<unsigned>(
+                        _mm256_movemask_ps(_mm256_castsi256_ps(same))) &
+                    0xFFu;
+    note_changed_bits(bits, x, 8, mask, acc);
+  }
+
+  alignas(32) uint64_t lanes[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sum);
+  acc.sum += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+  diff_row_scalar_from(a, b, mask, x, count, tolerance, acc);
+}
+#endif
+
+// Tile hash: each 32-byte stripe feeds four 64-bit lanes with
+// acc += v + lo32(v ^ key) * hi32(v ^ key), where the key depends on the
+// stripe index so moving rows inside a tile changes the hash. Every backend
+// computes identical values, since hashes are cached on disk.
+constexpr uint64_t kStripeKeys[4] = {0x9E3779B185EBCA87ull,
+                                     0xC2B2AE3D27D4EB4Full,
+                                     0x165667B19E3779F9ull,
+                                     0x27D4EB2F165667C5ull};
+constexpr uint64_t kStripeStep = 0x9E3779B97F4A7C15ull;
+
+// Hashes one image row into the accumulators of every tile it crosses.
+// acc holds four lanes per tile; y is the row's offset inside its tile band.
+using TileHashFn = void (*)(const uint8_t *row, int width, int y,
+                            uint64_t *acc);
+
+inline uint64_t load_u64(const uint8_t *p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline void hash_stripe(const uint8_t *p, uint64_t stripe, uint64_t acc[4]) {
+  for (int lane = 0; lane < 4; lane++) {
+    uint64_t v = load_u64(p + lane * 8);
+    uint64_t dk = v ^ (kStripeKeys[lane] + stripe * kStripeStep);
+    acc[lane] += v + (dk & 0xFFFFFFFFull) * (dk >> 32);
+  }
+}
+
+// Stripes of one tile's row segment; the last one is zero padded
+inline void hash_segment_scalar(const uint8_t *p, size_t bytes,
+                                uint64_t stripe, uint64_t acc[4]) {
+  size_t i = 0;
+  for (; i + 32 <= bytes; i += 32)
+    hash_stripe(p + i, stripe++, acc);
+  if (i < bytes) {
+    uint8_t buffer[32] = {};
+    std::memcpy(buffer, p + i, bytes - i);
+    hash_stripe(buffer, stripe, acc);
+  }
+}
+
+inline size_t stripes_per_row(int tile_w) {
+  return (static_cast<size_t>(tile_w) * 4 + 31) / 32;
+}
+
+void hash_row_scalar(const uint8_t *row, int width, int y, uint64_t *acc) {
+  for (int x0 = 0, tile = 0; x0 < width; x0 += kTileSize, tile++) {
+    const int tile_w = std::min(kTileSize, width - x0);
+    hash_segment_scalar(row + static_cast<size_t>(x0) * 4,
+                        static_cast<size_t>(tile_w) * 4,
+                        static_cast<uint64_t>(y) * stripes_per_row(tile_w),
+                        acc + tile * 4);
+  }
+}
+
+#ifdef IMAGE_DIFF_HAS_SSE2
+inline __m128i hash_lanes_sse2(__m128i acc, __m128i v, __m128i key) {
+  __m128i dk = _mm_xor_si128(v, key);
+  __m128i product = _mm_mul_epu32(dk, _mm_srli_epi64(dk, 32));
+  return _mm_add_epi64(acc, _mm_add_epi64(v, product));
+}
+
+void hash_row_sse2(const uint8_t *row, int width, int y, uint64_t *acc) {
+  const __m128i step = _mm_set1_epi64x(static_cast<long long>(kStripeStep));
+  const __m128i base_lo = _mm_set_epi64x(
+      static_cast<long long>(kStripeKeys[1]),
+      static_cast<long long>(kStripeKeys[0]));
+  const __m128i base_hi = _mm_set_epi64x(
+      static_cast<long long>(kStripeKeys[3]),
+      static_cast<long long>(kStripeKeys[2]));
+  // Full tiles always start at stripe y * 4
+  const __m128i offset = _mm_set1_epi64x(
+      static_cast<long long>(static_cast<uint64_t>(y) * 4 * kStripeStep));
+
+  int x0 = 0;
+  int tile = 0;
+  for (; x0 + kTileSize <= width; x0 += kTileSize, tile++) {
+    const uint8_t *p = row + static_cast<size_t>(x0) * 4;
+    uint64_t *lanes = acc + tile * 4;
+    __m128i acc_lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes));
+    __m128i acc_hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(lanes + 2));
+    __m128i key_lo = _mm_add_epi64(base_lo, offset);
+    __m128i key_hi = _mm_add_epi64(base_hi, offset);
+    for (int i = 0; i < kTileSize * 4; i += 32) {
+      __m128i v_lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+      __m128i v_hi =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 16));
+      acc_lo = hash_lanes_sse2(acc_lo, v_lo, key_lo);
+      acc_hi = hash_lanes_sse2(acc_hi, v_hi, key_hi);
+      key_lo = _mm_add_epi64(key_lo, step);
+      key_hi = _mm_add_epi64(key_hi, step);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc_lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes + 2), acc_hi);
+  }
+
+  if (x0 < width) {
+    const int tile_w = width - x0;
+    hash_segment_scalar(row + static_cast<size_t>(x0) * 4,
+                        static_cast<size_t>(tile_w) * 4,
+                        static_cast<uint64_t>(y) * stripes_per_row(tile_w),
+                        acc + tile * 4);
+  }
+}
+#endif
+
+#ifdef IMAGE_DIFF_HAS_AVX2
+__attribute__((target("avx2"))) void
+hash_row_avx2(const uint8_t *row, int width, int y, uint64_t *acc) {
+  const __m256i step =
+      _mm256_set1_epi64x(static_cast<long long>(kStripeStep));
+  const __m256i base = _mm256_set_epi64x(
+      static_cast<long long>(kStripeKeys[3]),
+      static_cast<long long>(kStripeKeys[2]),
+      static_cast<long long>(kStripeKeys[1]),
+      static_cast<long long>(kStripeKeys[0]));
+  const __m256i first_key = _mm256_add_epi64(
+      base, _mm256_set1_epi64x(static_cast<long long>(
+                static_cast<uint64_t>(y) * 4 * kStripeStep)));
+
+  int x0 = 0;
+  int tile = 0;
+  for (; x0 + kTileSize <= width; x0 += kTileSize, tile++) {
+    const uint8_t *p = row + static_cast<size_t>(x0) * 4;
+    uint64_t *lanes = acc + tile * 4;
+    __m256i sum = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes));
+    __m256i key = first_key;
+    for (int i = 0; i < kTileSize * 4; i += 32) {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+      __m256i dk = _mm256_xor_si256(v, key);
+      __m256i product = _mm256_mul_epu32(dk, _mm256_srli_epi64(dk, 32));
+      sum = _mm256_add_epi64(sum, _mm256_add_epi64(v, product));
+      key = _mm256_add_epi64(key, step);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), sum);
+  }
+
+  if (x0 < width) {
+    const int tile_w = width - x0;
+    hash_segment_scalar(row + static_cast<size_t>(x0) * 4,
+                        static_cast<size_t>(tile_w) * 4,
+                        static_cast<uint64_t>(y) * stripes_per_row(tile_w),
+                        acc + tile * 4);
+  }
+}
+#endif
+
+uint64_t finalize_tile_hash(const uint64_t acc[4], int tile_w, int tile_h) {
+  uint64_t h = std::rotl(acc[0], 1) + std::rotl(acc[1], 7) +
+               std::rotl(acc[2], 12) + std::rotl(acc[3], 18);
+  h ^= (static_cast<uint64_t>(tile_w) << 32) | static_cast<uint64_t>(tile_h);
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+struct Backend {
+  RowFn row;
+  TileHashFn hash;
+  const char *name;
+};
+
+Backend detect_backend() {
+#ifdef IMAGE_DIFF_HAS_AVX2
+  if (__builtin_cpu_supports("avx2")) {
+    return {diff_row_avx2, hash_row_avx2, "avx2"};
+  }
+#endif
+#ifdef IMAGE_DIFF_HAS_SSE2
+  return {diff_row_sse2, hash_row_sse2, "sse2"};
+#else
+  return {diff_row_scalar, hash_row_scalar, "scalar"};
+#endif
+}
+
+const Backend &backend() {
+  static const Backend instance = detect_backend();
+  return instance;
+}
+
+// Folds one row's accumulator into stats; x0 is the row's first pixel
+void add_row(DiffStats &stats, const RowAccum &acc, int x0, int y) {
+  stats.total_abs_diff += acc.sum;
+  if (acc.changed == 0)
+    return;
+  if (stats.changed_pixels == 0) {
+    stats.min_x = x0 + acc.first;
+    stats.max_x = x0 + acc.last;
+    stats.min_y = y;
+    stats.max_y = y;
+  } else {
+    stats.min_x = std::min(stats.min_x, x0 + acc.first);
+    stats.max_x = std::max(stats.max_x, x0 + acc.last);
+    stats.min_y = std::min(stats.min_y, y);
+    stats.max_y = std::max(stats.max_y, y);
+  }
+  stats.changed_pixels += acc.changed;
+}
+
+// Adds another region's totals and bounding box into stats
+void merge_stats(DiffStats &stats, const DiffStats &other) {
+  stats.total_abs_diff += other.total_abs_diff;
+  if (!other.has_changes())
+    return;
+  if (stats.changed_pixels == 0) {
+    stats.min_x = other.min_x;
+    stats.min_y = other.min_y;
+    stats.max_x = other.max_x;
+    stats.max_y = other.max_y;
+  } else {
+    stats.min_x = std::min(stats.min_x, other.min_x);
+    stats.min_y = std::min(stats.min_y, other.min_y);
+    stats.max_x = std::max(stats.max_x, other.max_x);
+    stats.max_y = std::max(stats.max_y, other.max_y);
+  }
+  stats.changed_pixels += other.changed_pixels;
+}
+
+DiffStats diff_with(RowFn row, const uint8_t *a, const uint8_t *b, int width,
+                    int height, uint8_t tolerance, uint8_t *mask) {
+  DiffStats stats;
+  if (!a || !b || width <= 0 || height <= 0)
+    return stats;
+
+  const size_t stride = static_cast<size_t>(width) * 4;
+  for (int y = 0; y < height; y++) {
+    RowAccum acc;
+    uint8_t *row_mask = mask ? mask + static_cast<size_t>(y) * width : nullptr;
+    row(a + y * stride, b + y * stride, row_mask, width, tolerance, acc);
+    add_row(stats, acc, 0, y);
+  }
+  return stats;
+}
+
+void hash_tiles_with(TileHashFn hash_row, const uint8_t *rgba, int width,
+                     int height, uint64_t *out) {
+  if (!rgba || width <= 0 || height <= 0)
+    return;
+  // Walk whole rows so reads stay sequential, accumulating one band of
+  // tiles at a time
+  const size_t stride = static_cast<size_t>(width) * 4;
+  const int tiles_x = (width + kTileSize - 1) / kTileSize;
+  std::vector<uint64_t> acc(static_cast<size_t>(tiles_x) * 4);
+  size_t index = 0;
+  for (int y0 = 0; y0 < height; y0 += kTileSize) {
+    const int tile_h = std::min(kTileSize, height - y0);
+    std::fill(acc.begin(), acc.end(), 0);
+    for (int y = 0; y < tile_h; y++) {
+      hash_row(rgba + (y0 + y) * stride, width, y, acc.data());
+    }
+    for (int tx = 0; tx < tiles_x; tx++) {
+      const int tile_w = std::min(kTileSize, width - tx * kTileSize);
+      out[index++] = finalize_tile_hash(acc.data() + tx * 4, tile_w, tile_h);
+    }
+  }
+}
+
+} // namespace
+
+DiffStats diff_rgba(const uint8_t *a, const uint8_t *b, int width, int height,
+                    uint8_t tolerance, uint8_t *mask) {
+  return diff_with(backend().row, a, b, width, height, tolerance, mask);
+}
+
+DiffStats diff_rgba_scalar(const uint8_t *a, const uint8_t *b, int width,
+                           int height, uint8_t tolerance, uint8_t *mask) {
+  return diff_with(diff_row_scalar, a, b, width, height, tolerance, mask);
+}
+
+const char *active_backend() { return backend().name; }
+
+float diff_percentage(const DiffStats &stats, int width, int height) {
+  if (width <= 0 || height <= 0)
+    return 0.0f;
+  double max_diff = static_cast<double>(width) * height * 255.0 * 3.0;
+  return static_cast<float>(static_cast<double>(stats.total_abs_diff) /
+                            max_diff * 100.0);
+}
+
+uint8_t tolerance_to_threshold(float tolerance) {
+  float threshold = std::floor(std::clamp(tolerance, 0.0f, 1.0f) * 255.0f);
+  return static_cast<uint8_t>(threshold);
+}
+
+void hash_tiles(const uint8_t *rgba, int width, int height, uint64_t *out) {
+  hash_tiles_with(backend().hash, rgba, width, height, out);
+}
+
+void hash_tiles_scalar(const uint8_t *rgba, int width, int height,
+                       uint64_t *out) {
+  hash_tiles_with(hash_row_scalar, rgba, width, height, out);
+}
+
+TiledDiff diff_rgba_tiled(const uint8_t *a, const uint8_t *b, int width,
+                          int height, uint8_t tolerance, uint8_t *mask,
+                          const uint64_t *a_tiles, const uint64_t *b_tiles) {
+  TiledDiff result;
+  if (!a || !b || width <= 0 || height <= 0)
+    return result;
+
+  const int tiles_x = (width + kTileSize - 1) / kTileSize;
+  const int tiles_y = (height + kTileSize - 1) / kTileSize;
+  const size_t count = static_cast<size_t>(tiles_x) * tiles_y;
+  result.tiles_total = static_cast<int>(count);
+
+  std::vector<uint64_t> a_local, b_local;
+  if (!a_tiles) {
+    a_local.resize(count);
+    hash_tiles(a, width, height, a_local.data());
+    a_tiles = a_local.data();
+  }
+  if (!b_tiles) {
+    b_local.resize(count);
+    hash_tiles(b, width, height, b_local.data());
+    b_tiles = b_local.data();
+  }
+
+  if (mask)
+    std::memset(mask, 0, static_cast<size_t>(width) * height);
+
+  // Per-tile stats for the tiles that actually contain changed pixels
+  std::vector<DiffStats> tile_stats(count);
+  const RowFn row = backend().row;
+  const size_t stride = static_cast<size_t>(width) * 4;
+
+  for (int ty = 0; ty < tiles_y; ty++) {
+    const int y0 = ty * kTileSize;
+    const int tile_h = std::min(kTileSize, height - y0);
+    for (int tx = 0; tx < tiles_x; tx++) {
+      const size_t index = static_cast<size_t>(ty) * tiles_x + tx;
+      if (a_tiles[index] == b_tiles[index])
+        continue;
+      result.tiles_compared++;
+
+      const int x0 = tx * kTileSize;
+      const int tile_w = std::min(kTileSize, width - x0);
+      DiffStats &tile = tile_stats[index];
+      for (int y = y0; y < y0 + tile_h; y++) {
+        const size_t offset = y * stride + static_cast<size_t>(x0) * 4;
+        uint8_t *row_mask =
+            mask ? mask + static_cast<size_t>(y) * width + x0 : nullptr;
+        RowAccum acc;
+        row(a + offset, b + offset, row_mask, tile_w, tolerance, acc);
+        add_row(tile, acc, x0, y);
+      }
+
+      merge_stats(result.stats, tile);
+    }
+  }
+
+  // Group touching changed tiles (8-connected) into regions
+  std::vector<uint8_t> visited(count, 0);
+  std::vector<size_t> stack;
+  for (size_t start = 0; start < count; start++) {
+    if (visited[start] || !tile_stats[start].has_changes())
+      continue;
+    DiffStats bounds;
+    visited[start] = 1;
+    stack.push_back(start);
+    while (!stack.empty()) {
+      const size_t index = stack.back();
+      stack.pop_back();
+      merge_stats(bounds, tile_stats[index]);
+
+      const int tx = static_cast<int>(index % static_cast<size_t>(tiles_x));
+      const int ty = static_cast<int>(index / static_cast<size_t>(tiles_x));
+      for (int ny = std::max(ty - 1, 0); ny <= std::min(ty + 1, tiles_y - 1);
+           ny++) {
+        for (int nx = std::max(tx - 1, 0);
+             nx <= std::min(tx + 1, tiles_x - 1); nx++) {
+          const size_t next = static_cast<size_t>(ny) * tiles_x + nx;
+          if (visited[next] || !tile_stats[next].has_changes())
+            continue;
+          visited[next] = 1;
+          stack.push_back(next);
+        }
+      }
+    }
+    result.changed_regions.push_back(Region{
+        bounds.min_x, bounds.min_y, bounds.max_x - bounds.min_x + 1,
+        bounds.max_y - bounds.min_y + 1});
+  }
+
+  return result;
+}
+
+} // namespace image_diff
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace image_diff {
+
+// Result of comparing two RGBA8 buffers
+struct DiffStats {
+  // Sum of absolute differences over the R, G and B channels
+  uint64_t total_abs_diff = 0;
+  // Pixels where any RGBA channel differs by more than the tolerance
+  int changed_pixels = 0;
+  // Inclusive bounding box of changed pixels (empty when max < min)
+  int min_x = 0;
+  int min_y = 0;
+  int max_x = -1;
+  int max_y = -1;
+
+  bool has_changes() const { return changed_pixels > 0; }
+};
+
+// Compares two tightly packed RGBA8 images of identical size in one pass.
+// If mask is non-null it receives width * height bytes, 255 for changed
+// pixels and 0 otherwise.
+DiffStats diff_rgba(const uint8_t *a, const uint8_t *b, int width, int height,
+                    uint8_t tolerance, uint8_t *mask = nullptr);
+
+// Same as diff_rgba but always uses the portable scalar path
+DiffStats diff_rgba_scalar(const uint8_t *a, const uint8_t *b, int width,
+                           int height, uint8_t tolerance,
+                           uint8_t *mask = nullptr);
+
+// Name of the kernel diff_rgba dispatches to ("avx2", "sse2" or "scalar")
+const char *active_backend();
+
+// Converts total_abs_diff into a 0-100 percentage of the maximum RGB diff
+float diff_percentage(const DiffStats &stats, int width, int height);
+
+// Converts a 0-1 tolerance into the per-channel threshold used by diff_rgba
+uint8_t tolerance_to_threshold(float tolerance);
+
+// Edge length of the square tiles used by the tiled diff
+constexpr int kTileSize = 32;
+
+inline int tile_count(int width, int height) {
+  return ((width + kTileSize - 1) / kTileSize) *
+         ((height + kTileSize - 1) / kTileSize);
+}
+
+// 64-bit content hash of every tile in row-major tile order. out must hold
+// tile_count(width, height) entries.
+void hash_tiles(const uint8_t *rgba, int width, int height, uint64_t *out);
+
+// Same as hash_tiles but always uses the portable scalar path. Both produce
+// identical hashes.
+void hash_tiles_scalar(const uint8_t *rgba, int width, int height,
+                       uint64_t *out);
+
+// Pixel rectangle, inclusive of x/y and exclusive of x+width/y+height
+struct Region {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+};
+
+struct TiledDiff {
+  DiffStats stats;
+  // Bounds of changed pixels, one per group of touching changed tiles
+  std::vector<Region> changed_regions;
+  // Tiles whose hashes differed and were compared pixel by pixel
+  int tiles_compared = 0;
+  int tiles_total = 0;
+};
+
+// Like diff_rgba, but only tiles whose hashes differ are compared pixel by
+// pixel. Precomputed tile hashes (from hash_tiles) can be passed for either
+// image; missing ones are computed here.
+TiledDiff diff_rgba_tiled(const uint8_t *a, const uint8_t *b, int width,
+                          int height, uint8_t tolerance,
+                          uint8_t *mask = nullptr,
+                          const uint64_t *a_tiles = nullptr,
+                          const uint64_t *b_tiles = nullptr);
+
+} // namespace image_diff
@@ -1,10 +1,14 @@
 #include "screenshot_validation.h"
 
+#include "../engine/trace.h"
 #include "../log.h"
 #include "../rl.h"
+#include "baseline_cache.h"
+#include "image_diff.h"
+#include "screenshot_writer.h"
 
-#include <cmath>
 #include <filesystem>
+#include <vector>
 
 // External reference to the main render texture from game.cpp
 extern raylib::RenderTexture2D mainRT;
@@ -18,6 +22,40 @@ void set_update_baselines(bool update) { g_update_baselines = update; }
 
 bool is_update_baselines() { return g_update_baselines; }
 
+namespace {
+
+// Reads mainRT back as an upright RGBA8 image (caller unloads it)
+raylib::Image capture_main_rt() {
+  TRACE_ZONE("screenshot readback");
+  raylib::Image image = raylib::LoadImageFromTexture(mainRT.texture);
+  if (image.data == nullptr) {
+    return image;
+  }
+  raylib::ImageFlipVertical(&image);
+  raylib::ImageFormat(&image, raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  return image;
+}
+
+float diff_percentage(raylib::Image &img1, raylib::Image &img2) {
+  // Size mismatch means different
+  if (img1.width != img2.width || img1.height != img2.height) {
+    log_warn("Image size mismatch: {}x{} vs {}x{}", img1.width, img1.height,
+             img2.width, img2.height);
+    return 100.0f;
+  }
+
+  raylib::ImageFormat(&img1, raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  raylib::ImageFormat(&img2, raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+  // Only the RGB sum is needed here, so no pixel can exceed a 255 threshold
+  image_diff::DiffStats stats = image_diff::diff_rgba(
+      static_cast<const uint8_t *>(img1.data),
+      static_cast<const uint8_t *>(img2.data), img1.width, img1.height, 255);
+  return image_diff::diff_percentage(stats, img1.width, img1.height);
+}
+
+} // namespace
+
 float calculate_image_diff_percentage(const std::string &path1,
                                       const std::string &path2) {
   raylib::Image img1 = raylib::LoadImage(path1.c_str());
@@ -31,96 +69,94 @@ float calculate_image_diff_percentage(const std::string &path1,
     return 100.0f; // Can't compare, treat as completely different
   }
 
-  // Size mismatch means different
-  if (img1.width != img2.width || img1.height != img2.height) {
-    raylib::UnloadImage(img1);
-    raylib::UnloadImage(img2);
-    log_warn("Image size mismatch: {}x{} vs {}x{}", img1.width, img1.height,
-             img2.width, img2.height);
-    return 100.0f;
-  }
-
-  // Get raw pixel data as RGBA
-  raylib::Color *pixels1 = raylib::LoadImageColors(img1);
-  raylib::Color *pixels2 = raylib::LoadImageColors(img2);
-
-  int total_pixels = img1.width * img1.height;
-  long long total_diff = 0;
-  long long max_diff = static_cast<long long>(total_pixels) * 255 * 3;
-
-  for (int i = 0; i < total_pixels; i++) {
-    total_diff += std::abs(static_cast<int>(pixels1[i].r) -
-                           static_cast<int>(pixels2[i].r));
-    total_diff += std::abs(static_cast<int>(pixels1[i].g) -
-                           static_cast<int>(pixels2[i].g));
-    total_diff += std::abs(static_cast<int>(pixels1[i].b) -
-                           static_cast<int>(pixels2[i].b));
-  }
+  float diff_pct = diff_percentage(img1, img2);
 
-  raylib::UnloadImageColors(pixels1);
-  raylib::UnloadImageColors(pixels2);
   raylib::UnloadImage(img1);
   raylib::UnloadImage(img2);
 
-  return (static_cast<float>(total_diff) / static_cast<float>(max_diff)) *
-         100.0f;
+  return diff_pct;
 }
 
 void save_screenshot_to(const std::string &path) {
-  raylib::Image image = raylib::LoadImageFromTexture(mainRT.texture);
-  if (image.data == nullptr) {
-    log_error("Failed to capture screenshot");
-    return;
-  }
-  raylib::ImageFlipVertical(&image);
-  raylib::ExportImage(image, path.c_str());
-  raylib::UnloadImage(image);
+  TRACE_ZONE("screenshot readback");
+  // Flip and png encode happen on the writer thread
+  screenshot_writer::write_png_async(
+      raylib::LoadImageFromTexture(mainRT.texture), path);
 }
 
 bool validate_screen_against_baseline(const std::string &screen_name) {
   std::string baseline_dir = "baseline_screenshots";
   std::string baseline_path = baseline_dir + "/" + screen_name + ".png";
-  std::string temp_path = "/tmp/validate_" + screen_name + ".png";
 
-  // Take screenshot of current state
-  save_screenshot_to(temp_path);
+  // Read back the current frame; it is only encoded if we need to keep it
+  raylib::Image current = capture_main_rt();
+  if (current.data == nullptr) {
+    log_error("[validate_screen] Failed to capture screenshot");
+    return false;
+  }
 
-  // In update-baselines mode, copy to baseline and pass
+  // In update-baselines mode, write the frame as the new baseline and pass
   if (g_update_baselines) {
-    // Ensure baseline directory exists
     std::filesystem::create_directories(baseline_dir);
-    std::filesystem::copy_file(
-        temp_path, baseline_path,
-        std::filesystem::copy_options::overwrite_existing);
-    log_info("[validate_screen] Updated baseline: {}", baseline_path);
+    screenshot_writer::write_png_async(
+        current, baseline_path,
+        {.flip_vertical = false,
+         .cache_baseline = true,
+         .saved_message = "[validate_screen] Updated baseline"});
     return true;
   }
 
   // Check if baseline exists
   if (!std::filesystem::exists(baseline_path)) {
+    raylib::UnloadImage(current);
     log_error("[validate_screen] Baseline not found: {}", baseline_path);
     log_error("Run with --update-baselines to create it");
     return false;
   }
 
-  // Compare images
-  float diff_pct = calculate_image_diff_percentage(baseline_path, temp_path);
-  log_info("[validate_screen] {} diff: {:.4f}%", screen_name, diff_pct);
+  // Make sure an earlier update of this baseline has reached disk
+  screenshot_writer::flush();
+
+  // Decoded baselines come from the raw RGBA cache when the png is unchanged
+  baseline_cache::Baseline baseline;
+  float diff_pct = 100.0f;
+  std::vector<image_diff::Region> changed_regions;
+  if (!baseline_cache::load(baseline_path, baseline)) {
+    log_error("[validate_screen] Failed to load baseline: {}", baseline_path);
+  } else if (baseline.width() != current.width ||
+             baseline.height() != current.height) {
+    log_warn("Image size mismatch: {}x{} vs {}x{}", baseline.width(),
+             baseline.height(), current.width, current.height);
+  } else {
+    // Only tiles whose hash differs from the cached baseline are diffed
+    image_diff::TiledDiff diff = image_diff::diff_rgba_tiled(
+        baseline.pixels(), static_cast<const uint8_t *>(current.data),
+        current.width, current.height, 0, nullptr, baseline.tile_hashes());
+    diff_pct = image_diff::diff_percentage(diff.stats, current.width,
+                                           current.height);
+    changed_regions = std::move(diff.changed_regions);
+  }
+  log_info("[validate_screen] {} diff: {:.4f}% ({} changed regions)",
+           screen_name, diff_pct, changed_regions.size());
 
   if (diff_pct > 1.0f) {
     log_error("[validate_screen] FAILED: {} differs by {:.4f}% (threshold: 1%)",
               screen_name, diff_pct);
-    // Keep the temp file for debugging
+    for (const image_diff::Region &region : changed_regions) {
+      log_error("  changed region: x={} y={} w={} h={}", region.x, region.y,
+                region.width, region.height);
+    }
+    // Keep the failing frame for debugging
     std::string fail_path = "/tmp/validate_FAILED_" + screen_name + ".png";
-    std::filesystem::copy_file(
-        temp_path, fail_path,
-        std::filesystem::copy_options::overwrite_existing);
-    log_error("Failed screenshot saved to: {}", fail_path);
+    screenshot_writer::write_png_async(
+        current, fail_path,
+        {.flip_vertical = false,
+         .saved_message = "[validate_screen] Failed screenshot saved to"});
     return false;
   }
 
+  raylib::UnloadImage(current);
   return true;
 }
 
 } // namespace screenshot_validation
-
@@ -0,0 +1,75 @@
+#include "screenshot_writer.h"
+
+#include "../engine/cache_file.h"
+#include "../engine/trace.h"
+#include "../engine/worker_pool.h"
+#include "../log.h"
+#include "baseline_cache.h"
+
+#include <span>
+
+namespace screenshot_writer {
+
+namespace {
+
+worker_pool::WorkerPool &pool() {
+  // One writer so writes land in submit order; two queued frames for the
+  // same path can never overlap or finish out of order. Each queued job
+  // holds a full frame, so keep the backlog small.
+  static worker_pool::WorkerPool instance(1, 4);
+  return instance;
+}
+
+// Encodes in memory and renames into place, so a reader never sees a
+// partial png
+bool export_png(const raylib::Image &image, const std::string &path) {
+  int size = 0;
+  unsigned char *png = raylib::ExportImageToMemory(image, ".png", &size);
+  if (png == nullptr) {
+    return false;
+  }
+  bool written = cache_file::write_atomic(
+      path, {std::span<const uint8_t>(png, static_cast<size_t>(size))});
+  raylib::MemFree(png);
+  return written;
+}
+
+void write_png(raylib::Image image, const std::string &path,
+               WriteOptions options) {
+  TRACE_ZONE("screenshot write");
+  if (options.flip_vertical) {
+    raylib::ImageFlipVertical(&image);
+  }
+  if (options.cache_baseline) {
+    raylib::ImageFormat(&image, raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  }
+
+  if (!export_png(image, path)) {
+    log_error("Failed to write screenshot: {}", path);
+  } else {
+    if (options.cache_baseline) {
+      baseline_cache::store(path, static_cast<const uint8_t *>(image.data),
+                            image.width, image.height);
+    }
+    if (options.saved_message) {
+      log_info("{}: {}", options.saved_message, path);
+    }
+  }
+  raylib::UnloadImage(image);
+}
+
+} // namespace
+
+void write_png_async(raylib::Image image, const std::string &path,
+                     WriteOptions options) {
+  if (image.data == nullptr) {
+    log_error("Failed to capture screenshot");
+    return;
+  }
+  pool().submit(
+      [image, path, options] { write_png(image, path, options); });
+}
+
+void flush() { pool().flush(); }
+
+} // namespace screenshot_writer
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "../rl.h"
+
+#include <string>
+
+namespace screenshot_writer {
+
+struct WriteOptions {
+  // Readbacks from a render texture are bottom-up and need flipping
+  bool flip_vertical = true;
+  // Also refresh the baseline_cache entry for the written png
+  bool cache_baseline = false;
+  // Logged with the path once the png is on disk, if set
+  const char *saved_message = nullptr;
+};
+
+// Takes ownership of image and encodes/writes it as a png on the writer
+// thread, in submit order. Blocks only when too many screenshots are
+// already queued.
+void write_png_async(raylib::Image image, const std::string &path,
+                     WriteOptions options = {});
+
+// Blocks until every queued screenshot is on disk. Call before reading a
+// png back, and before exit.
+void flush();
+
+} // namespace screenshot_writer
@@ -3,8 +3,16 @@
 #include "test_app.h"
 #include <functional>
 #include <map>
+#include <stdexcept>
 #include <string>
 
+// Helper to assert conditions in tests
+inline void assert_true(bool condition, const std::string &message) {
+  if (!condition) {
+    throw std::runtime_error(message);
+  }
+}
+
 struct TestRegistry {
   static TestRegistry &get() {
     static TestRegistry instance;
@@ -2,6 +2,9 @@
 #include "../external.h"
 #include "../game.h"
 #include "../input_mapping.h"
+#include "baseline_cache.h"
+#include "image_diff.h"
+#include "screenshot_writer.h"
 #include <afterhours/ah.h>
 #include <filesystem>
 #include <fstream>
@@ -41,9 +44,9 @@ SnapshotResult capture_snapshot(const std::string &name, int /*screen_width*/,
     return result;
   }
 
-  raylib::ImageFlipVertical(&image);
-  raylib::ExportImage(image, result.snapshot_path.c_str());
-  raylib::UnloadImage(image);
+  // Flip, encode and cache refresh run on the writer thread
+  screenshot_writer::write_png_async(image, result.snapshot_path,
+                                     {.cache_baseline = true});
 
   UIState state = capture_ui_state();
   std::string state_path = get_snapshot_state_path(name);
@@ -74,6 +77,9 @@ SnapshotResult compare_snapshot(const std::string &name, int /*screen_width*/,
   }
   raylib::ImageFlipVertical(&current_image);
 
+  // The expected snapshot may still be queued for writing
+  screenshot_writer::flush();
+
   if (!std::filesystem::exists(result.snapshot_path)) {
     raylib::UnloadImage(current_image);
     result.error_message =
@@ -81,94 +87,71 @@ SnapshotResult compare_snapshot(const std::string &name, int /*screen_width*/,
     return result;
   }
 
-  raylib::Image expected_image =
-      raylib::LoadImage(result.snapshot_path.c_str());
-  if (expected_image.data == nullptr) {
+  baseline_cache::Baseline expected;
+  if (!baseline_cache::load(result.snapshot_path, expected)) {
     raylib::UnloadImage(current_image);
     result.error_message =
         "Failed to load expected snapshot: " + result.snapshot_path;
     return result;
   }
 
-  if (current_image.width != expected_image.width ||
-      current_image.height != expected_image.height) {
+  if (current_image.width != expected.width() ||
+      current_image.height != expected.height()) {
     raylib::UnloadImage(current_image);
-    raylib::UnloadImage(expected_image);
     result.error_message = "Image size mismatch: expected " +
-                           std::to_string(expected_image.width) + "x" +
-                           std::to_string(expected_image.height) + ", got " +
+                           std::to_string(expected.width()) + "x" +
+                           std::to_string(expected.height()) + ", got " +
                            std::to_string(current_image.width) + "x" +
                            std::to_string(current_image.height);
     return result;
   }
 
-  int differences = 0;
-  float tolerance_pixels = tolerance * 255.0f;
-
-  for (int y = 0; y < current_image.height; y++) {
-    for (int x = 0; x < current_image.width; x++) {
-      raylib::Color current_color = raylib::GetImageColor(current_image, x, y);
-      raylib::Color expected_color =
-          raylib::GetImageColor(expected_image, x, y);
-
-      int r_diff = std::abs(static_cast<int>(current_color.r) -
-                            static_cast<int>(expected_color.r));
-      int g_diff = std::abs(static_cast<int>(current_color.g) -
-                            static_cast<int>(expected_color.g));
-      int b_diff = std::abs(static_cast<int>(current_color.b) -
-                            static_cast<int>(expected_color.b));
-      int a_diff = std::abs(static_cast<int>(current_color.a) -
-                            static_cast<int>(expected_color.a));
-
-      if (r_diff > tolerance_pixels || g_diff > tolerance_pixels ||
-          b_diff > tolerance_pixels || a_diff > tolerance_pixels) {
-        differences++;
-      }
-    }
+  raylib::ImageFormat(&current_image,
+                      raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+  const int width = current_image.width;
+  const int height = current_image.height;
+  std::vector<uint8_t> mask(static_cast<size_t>(width) * height);
+  image_diff::TiledDiff diff = image_diff::diff_rgba_tiled(
+      static_cast<const uint8_t *>(current_image.data), expected.pixels(),
+      width, height, image_diff::tolerance_to_threshold(tolerance),
+      mask.data(), nullptr, expected.tile_hashes());
+  const image_diff::DiffStats &stats = diff.stats;
+
+  result.pixel_differences = stats.changed_pixels;
+  for (const image_diff::Region &region : diff.changed_regions) {
+    result.changed_regions.push_back(raylib::Rectangle{
+        static_cast<float>(region.x), static_cast<float>(region.y),
+        static_cast<float>(region.width), static_cast<float>(region.height)});
   }
 
-  result.pixel_differences = differences;
+  if (stats.has_changes()) {
+    result.changed_bounds = raylib::Rectangle{
+        static_cast<float>(stats.min_x), static_cast<float>(stats.min_y),
+        static_cast<float>(stats.max_x - stats.min_x + 1),
+        static_cast<float>(stats.max_y - stats.min_y + 1)};
 
-  if (differences > 0) {
     std::string diff_path = get_snapshot_dir() + "/" + name + "_diff.png";
-    raylib::Image diff_image = raylib::ImageCopy(current_image);
-
-    for (int y = 0; y < current_image.height; y++) {
-      for (int x = 0; x < current_image.width; x++) {
-        raylib::Color current_color =
-            raylib::GetImageColor(current_image, x, y);
-        raylib::Color expected_color =
-            raylib::GetImageColor(expected_image, x, y);
-
-        int r_diff = std::abs(static_cast<int>(current_color.r) -
-                              static_cast<int>(expected_color.r));
-        int g_diff = std::abs(static_cast<int>(current_color.g) -
-                              static_cast<int>(expected_color.g));
-        int b_diff = std::abs(static_cast<int>(current_color.b) -
-                              static_cast<int>(expected_color.b));
-
-        if (r_diff > tolerance_pixels || g_diff > tolerance_pixels ||
-            b_diff > tolerance_pixels) {
-          raylib::ImageDrawPixel(&diff_image, x, y, raylib::RED);
-        } else {
-          raylib::Color gray = {128, 128, 128, 255};
-          raylib::ImageDrawPixel(&diff_image, x, y, gray);
-        }
-      }
+    raylib::Image diff_image =
+        raylib::GenImageColor(width, height, raylib::Color{128, 128, 128, 255});
+    raylib::Color *diff_pixels = static_cast<raylib::Color *>(diff_image.data);
+    for (size_t i = 0; i < mask.size(); i++) {
+      if (mask[i])
+        diff_pixels[i] = raylib::RED;
     }
 
     raylib::ExportImage(diff_image, diff_path.c_str());
     raylib::UnloadImage(diff_image);
     result.diff_path = diff_path;
     result.error_message =
-        "Snapshot comparison failed: " + std::to_string(differences) +
-        " pixels differ (tolerance: " + std::to_string(tolerance) + ")";
+        "Snapshot comparison failed: " + std::to_string(stats.changed_pixels) +
+        " pixels differ in " + std::to_string(diff.changed_regions.size()) +
+        " regions (tolerance: " + std::to_string(tolerance) + ")";
   } else {
     result.success = true;
   }
 
   raylib::UnloadImage(current_image);
-  raylib::UnloadImage(expected_image);
 
   std::string state_path = get_snapshot_state_path(name);
   UIState current_state = capture_ui_state();
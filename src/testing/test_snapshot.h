@@ -13,6 +13,10 @@ struct SnapshotResult {
   std::string snapshot_path;
   std::string diff_path;
   int pixel_differences = 0;
+  // Bounding box of all differing pixels (empty when nothing differs)
+  raylib::Rectangle changed_bounds{0, 0, 0, 0};
+  // Bounds of each separate cluster of differing pixels
+  std::vector<raylib::Rectangle> changed_regions;
 };
 
 struct UIState {
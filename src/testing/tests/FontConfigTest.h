@@ -5,18 +5,10 @@
 #include <afterhours/ah.h>
 #include <afterhours/src/plugins/translation.h>
 #include <afterhours/src/plugins/ui/theme.h>
-#include <stdexcept>
 
 using namespace afterhours::translation;
 using namespace afterhours::ui;
 
-// Helper to assert conditions in tests
-inline void assert_true(bool condition, const std::string &message) {
-  if (!condition) {
-    throw std::runtime_error(message);
-  }
-}
-
 // Test that FontConfig struct works correctly
 TEST(fontconfig_struct) {
   // Test default constructor
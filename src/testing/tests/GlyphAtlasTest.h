@@ -0,0 +1,37 @@
+#pragma once
+
+#include "../../engine/glyph_atlas.h"
+#include "../test_macros.h"
+
+// New glyphs fill free slots first, then replace the least recently used
+// unpinned glyph that was not needed this frame
+TEST(glyph_atlas_lru_eviction) {
+  glyph_atlas::SlotTable slots;
+  slots.reserve(3);
+
+  int ascii = slots.allocate('A', 0, true);
+  int ga = slots.allocate(0xAC00, 1, false);
+  int na = slots.allocate(0xB098, 2, false);
+  assert_true(ascii == 0 && ga == 1 && na == 2,
+              "slots should be handed out in order");
+  assert_true(slots.allocate(0xB2E4, 3, false) == -1,
+              "allocate should fail once the table is full");
+
+  // 0xAC00 is the oldest unpinned glyph
+  slots.touch(na, 3);
+  int evicted = -1;
+  int slot = slots.evict(0xB2E4, 3, evicted);
+  assert_true(slot == ga && evicted == 0xAC00 && slots.find(0xAC00) == -1 &&
+                  slots.find(0xB2E4) == ga,
+              "evict should reuse the least recently used slot");
+
+  // Everything left is pinned or used this frame
+  assert_true(slots.evict(0xB77C, 3, evicted) == -1,
+              "glyphs used this frame must not be evicted");
+
+  slots.reserve(4);
+  assert_true(slots.allocate(0xB77C, 3, false) == 3 && slots.used() == 4,
+              "growing should make new slots available");
+
+  co_return;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../../engine/gradient_texture.h"
+#include "../test_macros.h"
+
+namespace gradient_texture_test {
+inline bool is(raylib::Color c, int r, int g, int b, int a) {
+  return c.r == r && c.g == g && c.b == b && c.a == a;
+}
+} // namespace gradient_texture_test
+
+// Stops interpolate per channel, clamp at both ends and allow hard edges
+TEST(gradient_texture_sample) {
+  using gradient_texture_test::is;
+  const gradient_texture::Stop stops[] = {
+      {0.f, raylib::Color{0, 0, 0, 255}},
+      {0.5f, raylib::Color{200, 100, 0, 255}},
+      {0.5f, raylib::Color{0, 0, 255, 0}},
+      {1.f, raylib::Color{0, 0, 255, 255}},
+  };
+  assert_true(is(gradient_texture::sample(stops, -1.f), 0, 0, 0, 255) &&
+                  is(gradient_texture::sample(stops, 2.f), 0, 0, 255, 255),
+              "samples outside the stops should clamp");
+  assert_true(is(gradient_texture::sample(stops, 0.25f), 100, 50, 0, 255),
+              "midpoint should be halfway between stops");
+  assert_true(is(gradient_texture::sample(stops, 0.5f), 200, 100, 0, 255) &&
+                  is(gradient_texture::sample(stops, 0.75f), 0, 0, 255, 128),
+              "repeated position should be a hard edge");
+  co_return;
+}
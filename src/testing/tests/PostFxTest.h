@@ -0,0 +1,23 @@
+#pragma once
+
+#include "../../engine/post_fx.h"
+#include "../test_macros.h"
+
+// Pass lists from settings and --post-fx keep their order, treat empty and
+// "none" as no passes, and reject unknown names without touching the chain
+TEST(post_fx_parse) {
+  using post_fx::Pass;
+  std::vector<Pass> passes;
+  assert_true(post_fx::parse("crt,bloom,,vignette", passes) &&
+                  passes == std::vector<Pass>{Pass::Crt, Pass::Bloom,
+                                              Pass::Vignette},
+              "pass list should parse in order");
+  assert_true(post_fx::to_string(passes) == "crt,bloom,vignette",
+              "pass list should round trip");
+  assert_true(!post_fx::parse("vignette,blur", passes) && passes.size() == 3,
+              "unknown pass should fail and keep the list");
+  bool none = post_fx::parse("none", passes) && passes.empty();
+  bool empty = post_fx::parse("", passes) && passes.empty();
+  assert_true(none && empty, "none and empty should mean no passes");
+  co_return;
+}
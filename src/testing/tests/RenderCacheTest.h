@@ -0,0 +1,20 @@
+#pragma once
+
+#include "../../engine/render_cache.h"
+#include "../test_macros.h"
+
+// Layers redraw only when their key changes, so equal inputs must hash
+// equal and any changed byte must not
+TEST(render_cache_key) {
+  raylib::Color muted{120, 115, 105, 255};
+  raylib::Color brighter{121, 115, 105, 255};
+  uint64_t base = render_cache::Key{}.add(muted).add(3.0f).value();
+  assert_true(render_cache::Key{}.add(muted).add(3.0f).value() == base,
+              "same inputs should give the same key");
+  assert_true(render_cache::Key{}.add(brighter).add(3.0f).value() != base &&
+                  render_cache::Key{}.add(muted).add(4.0f).value() != base,
+              "changed inputs should change the key");
+  assert_true(render_cache::Key{}.add(3.0f).add(muted).value() != base,
+              "key should depend on input order");
+  co_return;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../../engine/resource_pack.h"
+#include "../test_macros.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace resource_pack_test {
+// Lays files out the way scripts/pack_resources.py does
+inline std::vector<uint8_t>
+build(std::vector<std::pair<std::string, std::string>> files) {
+  std::sort(files.begin(), files.end(), [](const auto &a, const auto &b) {
+    return resource_pack::hash_key(a.first) < resource_pack::hash_key(b.first);
+  });
+  auto put = [](std::vector<uint8_t> &out, size_t at, auto value) {
+    std::memcpy(out.data() + at, &value, sizeof(value));
+  };
+  const size_t keys_offset = 16 + 32 * files.size();
+  std::vector<uint8_t> out(keys_offset);
+  std::memcpy(out.data(), "AHRP", 4);
+  put(out, 4, uint32_t{1});
+  put(out, 8, static_cast<uint32_t>(files.size()));
+  for (size_t i = 0; i < files.size(); i++) {
+    put(out, 16 + 32 * i + 24, static_cast<uint32_t>(out.size()));
+    put(out, 16 + 32 * i + 28, static_cast<uint32_t>(files[i].first.size()));
+    out.insert(out.end(), files[i].first.begin(), files[i].first.end());
+  }
+  for (size_t i = 0; i < files.size(); i++) {
+    out.resize((out.size() + 15) / 16 * 16);
+    put(out, 16 + 32 * i, resource_pack::hash_key(files[i].first));
+    put(out, 16 + 32 * i + 8, static_cast<uint64_t>(out.size()));
+    put(out, 16 + 32 * i + 16, static_cast<uint64_t>(files[i].second.size()));
+    out.insert(out.end(), files[i].second.begin(), files[i].second.end());
+  }
+  return out;
+}
+} // namespace resource_pack_test
+
+// Lookups return views into the pack; damaged packs are rejected whole
+TEST(resource_pack_lookup) {
+  std::vector<uint8_t> bytes = resource_pack_test::build(
+      {{"fonts/Gaegu-Bold.ttf", "ttf bytes"},
+       {"gamecontrollerdb.txt", "mappings"},
+       {"kenney/Transparent border/panel.png", "png"}});
+
+  resource_pack::Pack pack;
+  assert_true(pack.attach(bytes.data(), bytes.size()) && pack.size() == 3,
+              "valid pack should attach");
+  std::span<const uint8_t> font = pack.find("fonts/Gaegu-Bold.ttf");
+  assert_true(std::string(font.begin(), font.end()) == "ttf bytes" &&
+                  font.data() >= bytes.data() &&
+                  font.data() < bytes.data() + bytes.size(),
+              "entry should be a view into the pack");
+  std::span<const uint8_t> panel =
+      pack.find("kenney/Transparent border/panel.png");
+  assert_true(std::string(panel.begin(), panel.end()) == "png",
+              "keys with spaces should be found");
+  assert_true(pack.find("fonts/missing.ttf").empty(),
+              "unpacked files should not be found");
+
+  std::vector<uint8_t> truncated(bytes.begin(), bytes.end() - 2);
+  assert_true(!pack.attach(truncated.data(), truncated.size()) &&
+                  pack.size() == 0,
+              "entries past the end should be rejected");
+  bytes[0] = 'X';
+  assert_true(!pack.attach(bytes.data(), bytes.size()),
+              "bad magic should be rejected");
+
+  co_return;
+}
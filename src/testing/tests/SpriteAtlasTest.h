@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../../engine/sprite_atlas.h"
+#include "../test_macros.h"
+
+// The lookup table written by scripts/pack_atlas.py
+TEST(sprite_atlas_index_parse) {
+  sprite_atlas::Index index;
+  bool ok = index.parse("# generated by scripts/pack_atlas.py, 2 sprites\n"
+                        "page atlas_0.png 1024 256\n"
+                        "sprite images/icon_uav.png 0 2 2 36 36\n"
+                        "sprite images/sparkle.png 0 42 2 16 16\r\n");
+  assert_true(ok && index.size() == 2 && index.pages().size() == 1,
+              "valid table should parse");
+  const sprite_atlas::Region *uav = index.find("images/icon_uav.png");
+  assert_true(uav && uav->page == 0 && uav->source.x == 2.0f &&
+                  uav->source.width == 36.0f,
+              "region should match its line");
+  assert_true(index.find("images/icon_skull.png") == nullptr,
+              "unpacked sprites should not be found");
+
+  // Unknown pages and trailing fields reject the whole table, so a stale
+  // atlas falls back to loose files instead of drawing the wrong region
+  assert_true(!index.parse("page atlas_0.png 64 64\n"
+                           "sprite a.png 1 0 0 8 8\n") &&
+                  index.size() == 0,
+              "sprite on a missing page should be rejected");
+  assert_true(!index.parse("page atlas_0.png 64 64 extra\n"),
+              "trailing fields should be rejected");
+
+  co_return;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../../engine/texture_cache.h"
+#include "../test_macros.h"
+
+namespace texture_cache_test {
+inline int loads = 0;
+inline int unloads = 0;
+
+// 16x16 RGBA, 1 KiB per texture
+inline raylib::Texture2D fake_load(const char *) {
+  loads++;
+  raylib::Texture2D texture{};
+  texture.id = static_cast<unsigned int>(loads);
+  texture.width = 16;
+  texture.height = 16;
+  texture.mipmaps = 1;
+  texture.format = raylib::PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+  return texture;
+}
+inline void fake_unload(raylib::Texture2D) { unloads++; }
+} // namespace texture_cache_test
+
+// Same path shares one texture; released textures stay cached until the
+// idle budget is exceeded, oldest first
+TEST(texture_cache_refcount_and_eviction) {
+  using namespace texture_cache_test;
+  loads = 0;
+  unloads = 0;
+  texture_cache::Cache cache(fake_load, fake_unload, 2048);
+
+  {
+    texture_cache::Handle a = cache.acquire("a.png");
+    texture_cache::Handle a2 = cache.acquire("a.png");
+    assert_true(loads == 1 && a.get().id == a2.get().id,
+                "same path should load once");
+    texture_cache::Handle b = cache.acquire("b.png");
+    assert_true(cache.stats().referenced == 2,
+                "both textures should be referenced");
+  }
+  assert_true(unloads == 0 && cache.stats().idle_bytes == 2048,
+              "released textures within budget should stay");
+
+  // Reacquiring an idle texture is a hit and takes it out of the idle list
+  texture_cache::Handle a = cache.acquire("a.png");
+  assert_true(loads == 2 && cache.stats().idle_bytes == 1024,
+              "idle texture should be reused");
+
+  // Releasing c and d pushes the idle set over budget, b was released first
+  {
+    texture_cache::Handle c = cache.acquire("c.png");
+    texture_cache::Handle d = cache.acquire("d.png");
+  }
+  assert_true(unloads == 1 && cache.stats().textures == 3,
+              "oldest idle texture should be evicted");
+  texture_cache::Handle b = cache.acquire("b.png");
+  assert_true(loads == 5, "evicted texture should load again");
+
+  cache.unload_all();
+  assert_true(a.get().id == 0, "unload_all should clear live handles");
+
+  co_return;
+}
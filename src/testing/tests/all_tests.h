@@ -1,7 +1,14 @@
 #pragma once
 
 #include "FontConfigTest.h"
+#include "GlyphAtlasTest.h"
+#include "GradientTextureTest.h"
+#include "PostFxTest.h"
+#include "RenderCacheTest.h"
+#include "ResourcePackTest.h"
 #include "SimpleButtonClickTest.h"
 #include "SnapshotTest.h"
 #include "SportsSettingsTest.h"
+#include "SpriteAtlasTest.h"
 #include "TabbingTest.h"
+#include "TextureCacheTest.h"
@@ -0,0 +1,41 @@
+#pragma once
+
+// WORKAROUND: Named Atlas Regions
+// See LIBRARY_GAPS.md (new gap to add)
+//
+// The library's sprite() takes a texture and source rect, so every screen
+// had to load and keep its own sprite_atlas::Sprite fields. atlas_sprite()
+// takes the sprite's resource path instead and resolves it through
+// engine/sprite_atlas: a region of a packed page after `make atlas`, the
+// loose file otherwise. The page is held by the screen's TextureSet, so it
+// is released with the screen like any other texture.
+//
+// Migration: When library adds with_atlas_region() on images, replace these
+// calls with the native implementation.
+
+#include "../engine/sprite_atlas.h"
+#include <afterhours/ah.h>
+#include <string>
+#include <utility>
+
+namespace ui_workarounds {
+
+using namespace afterhours::ui;
+using namespace afterhours::ui::imm;
+
+// Draws the sprite stored under key (e.g. "images/icon_uav.png") with
+// config's size and position. Returns false, drawing nothing, if it could
+// not be loaded, so callers can show a fallback.
+template <typename Context, typename Entity>
+inline bool atlas_sprite(Context &context, Entity &entity, int id,
+                         texture_cache::TextureSet &textures,
+                         const std::string &key, ComponentConfig config) {
+  sprite_atlas::Sprite region = sprite_atlas::load(textures, key);
+  if (!region)
+    return false;
+  sprite(context, mk(entity, id), region.texture, region.source,
+         std::move(config));
+  return true;
+}
+
+} // namespace ui_workarounds
@@ -3,67 +3,80 @@
 // WORKAROUND: Gradient Backgrounds
 // See LIBRARY_GAPS.md #30
 //
-// This helper approximates gradients by layering multiple semi-transparent
-// horizontal strips. Not as smooth as real gradients but provides depth.
+// The library has no gradient fill, so these helpers bake the gradient into
+// a small cached texture (engine/gradient_texture) and stretch it over the
+// box as one sprite: one entity and one quad however smooth the gradient.
 //
 // Migration: When library adds with_gradient_background(), replace these calls
 // with the native implementation.
 
+#include "../engine/gradient_texture.h"
 #include <afterhours/ah.h>
+#include <algorithm>
+#include <array>
+#include <initializer_list>
 
 namespace ui_workarounds {
 
 using namespace afterhours::ui;
 using namespace afterhours::ui::imm;
 
-// Renders a vertical gradient (top to bottom) using horizontal strips
-template <typename Context, typename Entity>
-inline void
-vertical_gradient(Context &context, Entity &entity, int base_id, float x,
-                  float y, float width, float height,
-                  afterhours::Color top_color, afterhours::Color bottom_color,
-                  int num_strips = 8 // More strips = smoother gradient
-) {
-  float strip_height = height / static_cast<float>(num_strips);
+struct GradientStop {
+  // 0 at the start of the gradient, 1 at the end
+  float position;
+  afterhours::Color color;
+};
 
-  for (int i = 0; i < num_strips; i++) {
-    float t = static_cast<float>(i) / static_cast<float>(num_strips - 1);
-    afterhours::Color strip_color = afterhours::colors::lerp(top_color, bottom_color, t);
+// Stops beyond this are ignored
+constexpr size_t MAX_GRADIENT_STOPS = 8;
 
-    div(context, mk(entity, base_id + i),
-        ComponentConfig{}
-            .with_size(ComponentSize{
-                pixels(static_cast<int>(width)),
-                pixels(static_cast<int>(strip_height + 1))}) // +1 to avoid gaps
-            .with_absolute_position()
-            .with_translate(x, y + i * strip_height)
-            .with_custom_background(strip_color)
-            .with_debug_name("gradient_strip_" + std::to_string(i)));
+// Renders a linear gradient through stops (sorted by position). angle is in
+// degrees: 0 runs left to right, 90 top to bottom.
+template <typename Context, typename Entity>
+inline void linear_gradient(Context &context, Entity &entity, int id, float x,
+                            float y, float width, float height,
+                            std::initializer_list<GradientStop> stops,
+                            float angle_degrees) {
+  std::array<gradient_texture::Stop, MAX_GRADIENT_STOPS> baked_stops;
+  size_t count = std::min(stops.size(), MAX_GRADIENT_STOPS);
+  for (size_t i = 0; i < count; i++) {
+    const GradientStop &stop = stops.begin()[i];
+    baked_stops[i] = {stop.position,
+                      raylib::Color{stop.color.r, stop.color.g, stop.color.b,
+                                    stop.color.a}};
   }
+  const raylib::Texture2D &texture = gradient_texture::get(
+      std::span(baked_stops.data(), count), angle_degrees, width, height);
+
+  raylib::Rectangle source{0, 0, static_cast<float>(texture.width),
+                           static_cast<float>(texture.height)};
+  sprite(context, mk(entity, id), texture, source,
+         ComponentConfig{}
+             .with_size(ComponentSize{pixels(static_cast<int>(width)),
+                                      pixels(static_cast<int>(height))})
+             .with_absolute_position()
+             .with_translate(x, y)
+             .with_debug_name("gradient"));
 }
 
-// Renders a horizontal gradient (left to right) using vertical strips
+// Renders a vertical gradient (top to bottom)
 template <typename Context, typename Entity>
-inline void horizontal_gradient(Context &context, Entity &entity, int base_id,
+inline void vertical_gradient(Context &context, Entity &entity, int id,
+                              float x, float y, float width, float height,
+                              afterhours::Color top_color,
+                              afterhours::Color bottom_color) {
+  linear_gradient(context, entity, id, x, y, width, height,
+                  {{0.f, top_color}, {1.f, bottom_color}}, 90.f);
+}
+
+// Renders a horizontal gradient (left to right)
+template <typename Context, typename Entity>
+inline void horizontal_gradient(Context &context, Entity &entity, int id,
                                 float x, float y, float width, float height,
                                 afterhours::Color left_color,
-                                afterhours::Color right_color,
-                                int num_strips = 8) {
-  float strip_width = width / static_cast<float>(num_strips);
-
-  for (int i = 0; i < num_strips; i++) {
-    float t = static_cast<float>(i) / static_cast<float>(num_strips - 1);
-    afterhours::Color strip_color = afterhours::colors::lerp(left_color, right_color, t);
-
-    div(context, mk(entity, base_id + i),
-        ComponentConfig{}
-            .with_size(ComponentSize{pixels(static_cast<int>(strip_width + 1)),
-                                     pixels(static_cast<int>(height))})
-            .with_absolute_position()
-            .with_translate(x + i * strip_width, y)
-            .with_custom_background(strip_color)
-            .with_debug_name("gradient_strip_" + std::to_string(i)));
-  }
+                                afterhours::Color right_color) {
+  linear_gradient(context, entity, id, x, y, width, height,
+                  {{0.f, left_color}, {1.f, right_color}}, 0.f);
 }
 
 } // namespace ui_workarounds